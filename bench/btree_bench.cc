@@ -0,0 +1,362 @@
+// Streams keys from every UUID version into a simulated B+tree and reports
+// how the key order affects page splits, pages touched per insert, buffer
+// pool misses and final page utilization.
+//
+//   btree_bench [--count <n>] [--page-size <bytes>] [--fill-factor <0.5-1.0>]
+//               [--entry-size <bytes>] [--pool-pages <n>]
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+#include "vscuuid/uuid_factory.hh"
+#include "vscuuid/uuid_generators.hh"
+
+namespace {
+
+struct TreeOptions {
+  std::size_t page_size = 8192;
+  // Bytes per leaf entry (16-byte key plus row pointer) and per child
+  // reference in internal pages.
+  std::size_t entry_size = 24;
+  // Share of a page kept when the rightmost page splits under appends, like
+  // PostgreSQL's fillfactor; other splits are 50/50.
+  double fill_factor = 0.9;
+  std::size_t pool_pages = 1024;
+};
+
+struct Key {
+  uint64_t hi;
+  uint64_t lo;
+
+  friend bool operator<(const Key& a, const Key& b) { return a.hi < b.hi || (a.hi == b.hi && a.lo < b.lo); }
+};
+
+Key ToKey(const vscuuid::Uuid& uuid) {
+  Key key{0, 0};
+  for (int i = 0; i < 8; ++i) {
+    key.hi = (key.hi << 8) | uuid.bytes()[i];
+    key.lo = (key.lo << 8) | uuid.bytes()[8 + i];
+  }
+  return key;
+}
+
+// An LRU buffer pool over page ids, kept as an intrusive list. A miss stands
+// in for a page read and the eviction of a dirty page for a page write.
+class BufferPool {
+ public:
+  explicit BufferPool(std::size_t capacity) : capacity_(std::max<std::size_t>(1, capacity)) {}
+
+  void Touch(uint32_t page, bool dirty) {
+    if (page >= entries_.size()) {
+      entries_.resize(page + 1);
+    }
+    Entry& entry = entries_[page];
+    if (entry.resident) {
+      Unlink(page);
+    } else {
+      ++misses_;
+      entry.resident = true;
+      if (++resident_ > capacity_) {
+        Evict();
+      }
+    }
+    entry.dirty = entry.dirty || dirty;
+    PushFront(page);
+  }
+
+  uint64_t misses() const { return misses_; }
+
+  // Writes every dirty page still cached, as a checkpoint would.
+  uint64_t FlushedWrites() const {
+    uint64_t dirty = 0;
+    for (const Entry& entry : entries_) {
+      dirty += entry.resident && entry.dirty ? 1 : 0;
+    }
+    return writes_ + dirty;
+  }
+
+ private:
+  static constexpr uint32_t kNone = ~uint32_t{0};
+
+  struct Entry {
+    uint32_t prev = kNone;
+    uint32_t next = kNone;
+    bool resident = false;
+    bool dirty = false;
+  };
+
+  void Unlink(uint32_t page) {
+    Entry& entry = entries_[page];
+    (entry.prev != kNone ? entries_[entry.prev].next : head_) = entry.next;
+    (entry.next != kNone ? entries_[entry.next].prev : tail_) = entry.prev;
+  }
+
+  void PushFront(uint32_t page) {
+    Entry& entry = entries_[page];
+    entry.prev = kNone;
+    entry.next = head_;
+    (head_ != kNone ? entries_[head_].prev : tail_) = page;
+    head_ = page;
+  }
+
+  void Evict() {
+    uint32_t victim = tail_;
+    Unlink(victim);
+    Entry& entry = entries_[victim];
+    writes_ += entry.dirty ? 1 : 0;
+    entry = Entry();
+    --resident_;
+  }
+
+  std::size_t capacity_;
+  std::size_t resident_ = 0;
+  std::vector<Entry> entries_;
+  uint32_t head_ = kNone;
+  uint32_t tail_ = kNone;
+  uint64_t misses_ = 0;
+  uint64_t writes_ = 0;
+};
+
+struct TreeStats {
+  uint64_t inserts = 0;
+  uint64_t leaf_splits = 0;
+  uint64_t internal_splits = 0;
+  uint64_t touched_pages = 0;
+  uint64_t leaf_pages = 0;
+  uint64_t leaf_entries = 0;
+  unsigned height = 0;
+};
+
+// Keys only: the simulator tracks which pages an insert reads, modifies and
+// creates, not the rows themselves.
+class BTreeSimulator {
+ public:
+  explicit BTreeSimulator(const TreeOptions& options)
+      : options_(options),
+        leaf_capacity_((options.page_size - kPageHeader) / options.entry_size),
+        internal_capacity_((options.page_size - kPageHeader) / options.entry_size),
+        pool_(options.pool_pages) {
+    root_ = NewNode(true);
+  }
+
+  void Insert(const Key& key) {
+    ++stats_.inserts;
+    path_.clear();
+    Node* node = root_;
+    bool rightmost = true;
+    while (!node->leaf) {
+      Touch(node, false);
+      std::size_t child = std::upper_bound(node->keys.begin(), node->keys.end(), key) - node->keys.begin();
+      rightmost = rightmost && child == node->children.size() - 1;
+      path_.push_back({node, child});
+      node = node->children[child];
+    }
+    std::size_t position = std::upper_bound(node->keys.begin(), node->keys.end(), key) - node->keys.begin();
+    const bool append = rightmost && position == node->keys.size();
+    node->keys.insert(node->keys.begin() + position, key);
+    Touch(node, true);
+    ++stats_.leaf_entries;
+
+    if (node->keys.size() <= leaf_capacity_) {
+      return;
+    }
+    // Split upwards while pages overflow. Appends at the right edge keep the
+    // left page fill_factor full, since nothing will be inserted into it again.
+    ++stats_.leaf_splits;
+    Node* right = NewNode(true);
+    std::size_t keep = SplitPoint(node->keys.size(), leaf_capacity_, append);
+    right->keys.assign(node->keys.begin() + keep, node->keys.end());
+    node->keys.resize(keep);
+    Key separator = right->keys.front();
+    Node* left = node;
+    while (true) {
+      if (path_.empty()) {
+        Node* root = NewNode(false);
+        root->keys.push_back(separator);
+        root->children = {left, right};
+        root_ = root;
+        return;
+      }
+      auto [parent, child] = path_.back();
+      path_.pop_back();
+      parent->keys.insert(parent->keys.begin() + child, separator);
+      parent->children.insert(parent->children.begin() + child + 1, right);
+      Touch(parent, true);
+      if (parent->children.size() <= internal_capacity_) {
+        return;
+      }
+      ++stats_.internal_splits;
+      Node* sibling = NewNode(false);
+      const bool parent_append = append && child + 2 == parent->children.size();
+      std::size_t keep_children = SplitPoint(parent->children.size(), internal_capacity_, parent_append);
+      separator = parent->keys[keep_children - 1];
+      sibling->keys.assign(parent->keys.begin() + keep_children, parent->keys.end());
+      sibling->children.assign(parent->children.begin() + keep_children, parent->children.end());
+      parent->keys.resize(keep_children - 1);
+      parent->children.resize(keep_children);
+      left = parent;
+      right = sibling;
+    }
+  }
+
+  TreeStats Finish() {
+    TreeStats stats = stats_;
+    stats.leaf_pages = 0;
+    stats.height = 1;
+    for (const Node* node = root_; !node->leaf; node = node->children.front()) {
+      ++stats.height;
+    }
+    for (const Node& node : nodes_) {
+      stats.leaf_pages += node.leaf ? 1 : 0;
+    }
+    return stats;
+  }
+
+  std::size_t leaf_capacity() const { return leaf_capacity_; }
+  const BufferPool& pool() const { return pool_; }
+
+ private:
+  static constexpr std::size_t kPageHeader = 64;
+
+  struct Node {
+    uint32_t id;
+    bool leaf;
+    std::vector<Key> keys;
+    std::vector<Node*> children;
+  };
+
+  Node* NewNode(bool leaf) {
+    nodes_.push_back(Node{static_cast<uint32_t>(nodes_.size()), leaf, {}, {}});
+    Node* node = &nodes_.back();
+    Touch(node, true);
+    return node;
+  }
+
+  void Touch(Node* node, bool dirty) {
+    ++stats_.touched_pages;
+    pool_.Touch(node->id, dirty);
+  }
+
+  std::size_t SplitPoint(std::size_t size, std::size_t capacity, bool append) const {
+    if (append) {
+      std::size_t keep = static_cast<std::size_t>(static_cast<double>(capacity) * options_.fill_factor);
+      return std::clamp<std::size_t>(keep, 1, size - 1);
+    }
+    return size / 2;
+  }
+
+  TreeOptions options_;
+  std::size_t leaf_capacity_;
+  std::size_t internal_capacity_;
+  BufferPool pool_;
+  std::deque<Node> nodes_;
+  Node* root_ = nullptr;
+  TreeStats stats_;
+  std::vector<std::pair<Node*, std::size_t>> path_;
+};
+
+struct Workload {
+  const char* name;
+  vscuuid::UuidFactory::UuidType type;
+  bool monotonic;
+};
+
+// Name-based versions need distinct names to produce distinct keys.
+std::vector<vscuuid::Uuid> GenerateKeys(const Workload& workload, std::size_t count) {
+  std::vector<vscuuid::Uuid> keys(count);
+  const char* kNamespace = "6ba7b810-9dad-11d1-80b4-00c04fd430c8";
+  if (workload.type == vscuuid::UuidFactory::UuidType::V3) {
+    vscuuid::UuidV3Generator generator;
+    for (std::size_t i = 0; i < count; ++i) {
+      keys[i] = generator.GenerateUuid(kNamespace, "row-" + std::to_string(i));
+    }
+  } else if (workload.type == vscuuid::UuidFactory::UuidType::V5) {
+    vscuuid::UuidV5Generator generator;
+    for (std::size_t i = 0; i < count; ++i) {
+      keys[i] = generator.GenerateUuid(kNamespace, "row-" + std::to_string(i));
+    }
+  } else {
+    std::unique_ptr<vscuuid::UuidGeneratorBase> generator = vscuuid::UuidFactory::Create(workload.type);
+    if (workload.monotonic) {
+      static_cast<vscuuid::UuidV7Generator&>(*generator).SetMonotonic(true);
+    }
+    generator->GenerateUuids(keys);
+  }
+  return keys;
+}
+
+void PrintUsage() {
+  std::fprintf(stderr,
+               "Usage: btree_bench [--count <n>] [--page-size <bytes>] [--fill-factor <0.5-1.0>]\n"
+               "                   [--entry-size <bytes>] [--pool-pages <n>]\n");
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  std::size_t count = 1000000;
+  TreeOptions options;
+  for (int i = 1; i < argc; ++i) {
+    if (i + 1 >= argc) {
+      PrintUsage();
+      return 2;
+    }
+    if (std::strcmp(argv[i], "--count") == 0) {
+      count = std::stoull(argv[++i]);
+    } else if (std::strcmp(argv[i], "--page-size") == 0) {
+      options.page_size = std::stoull(argv[++i]);
+    } else if (std::strcmp(argv[i], "--fill-factor") == 0) {
+      options.fill_factor = std::stod(argv[++i]);
+    } else if (std::strcmp(argv[i], "--entry-size") == 0) {
+      options.entry_size = std::stoull(argv[++i]);
+    } else if (std::strcmp(argv[i], "--pool-pages") == 0) {
+      options.pool_pages = std::stoull(argv[++i]);
+    } else {
+      PrintUsage();
+      return 2;
+    }
+  }
+  if (options.entry_size < 16 || options.page_size < 64 + 4 * options.entry_size || options.fill_factor < 0.5 ||
+      options.fill_factor > 1.0) {
+    std::fprintf(stderr, "Pages must hold at least 4 entries of 16+ bytes and the fill factor be 0.5-1.0\n");
+    return 2;
+  }
+
+  using Type = vscuuid::UuidFactory::UuidType;
+  const Workload workloads[] = {
+      {"v1", Type::V1, false}, {"v2", Type::V2, false}, {"v3", Type::V3, false},
+      {"v4", Type::V4, false}, {"v5", Type::V5, false}, {"v6", Type::V6, false},
+      {"v7", Type::V7, false}, {"v7+ctr", Type::V7, true}, {"v8", Type::V8, false},
+  };
+
+  std::printf("%zu inserts, %zu-byte pages, %zu-byte entries, fill factor %.2f, %zu-page LRU pool\n", count,
+              options.page_size, options.entry_size, options.fill_factor, options.pool_pages);
+  std::printf("%-7s %10s %9s %7s %10s %10s %10s %7s %6s\n", "keys", "leaf-spl", "int-spl", "height", "touch/ins",
+              "miss/ins", "write/ins", "util%", "WA");
+  for (const Workload& workload : workloads) {
+    std::vector<vscuuid::Uuid> keys = GenerateKeys(workload, count);
+    BTreeSimulator tree(options);
+    for (const vscuuid::Uuid& uuid : keys) {
+      tree.Insert(ToKey(uuid));
+    }
+    TreeStats stats = tree.Finish();
+    const double inserts = static_cast<double>(std::max<uint64_t>(1, stats.inserts));
+    const double writes = static_cast<double>(tree.pool().FlushedWrites());
+    const double utilization = 100.0 * static_cast<double>(stats.leaf_entries) /
+                               static_cast<double>(stats.leaf_pages * tree.leaf_capacity());
+    // Write amplification: bytes of pages written per byte of entry inserted.
+    const double amplification = writes * static_cast<double>(options.page_size) /
+                                 (inserts * static_cast<double>(options.entry_size));
+    std::printf("%-7s %10llu %9llu %7u %10.2f %10.4f %10.4f %7.1f %6.2f\n", workload.name,
+                static_cast<unsigned long long>(stats.leaf_splits),
+                static_cast<unsigned long long>(stats.internal_splits), stats.height,
+                static_cast<double>(stats.touched_pages) / inserts,
+                static_cast<double>(tree.pool().misses()) / inserts, writes / inserts, utilization, amplification);
+  }
+  return 0;
+}
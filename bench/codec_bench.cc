@@ -0,0 +1,87 @@
+// Compression ratio and throughput of CompressedUuids on sorted V1, V6 and V7
+// streams.
+//
+//   codec_bench [--count <n>] [--rounds <n>]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "vscuuid/uuid_codec.hh"
+#include "vscuuid/uuid_generators.hh"
+
+namespace {
+
+// Keeps the compiler from discarding lookups whose results are unused.
+volatile uint64_t g_sink;
+
+template <typename Body>
+double BestSeconds(int rounds, Body body) {
+  double best = 1e300;
+  for (int round = 0; round < rounds; ++round) {
+    auto begin = std::chrono::steady_clock::now();
+    body();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    best = std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+void Run(const char* name, vscuuid::UuidGeneratorBase& generator, std::size_t count, int rounds) {
+  std::vector<vscuuid::Uuid> sorted(count);
+  generator.GenerateUuids(sorted);
+  std::sort(sorted.begin(), sorted.end());
+
+  vscuuid::CompressedUuids compressed;
+  double encode = BestSeconds(rounds, [&] { compressed = vscuuid::CompressedUuids::Encode(sorted); });
+  std::vector<vscuuid::Uuid> decoded(count);
+  double decode = BestSeconds(rounds, [&] { compressed.Decode(decoded); });
+  if (decoded != sorted) {
+    std::fprintf(stderr, "%s: decoded stream differs from the input\n", name);
+    return;
+  }
+  std::size_t probes = std::min<std::size_t>(count, 100000);
+  uint64_t checksum = 0;
+  double lookup = BestSeconds(rounds, [&] {
+    for (std::size_t i = 0; i < probes; ++i) {
+      checksum += compressed.At((i * 7919) % count).bytes()[15];
+    }
+  });
+
+  const double raw_bytes = static_cast<double>(count) * sizeof(vscuuid::Uuid);
+  const double bytes_per_uuid = static_cast<double>(compressed.bytes().size()) / static_cast<double>(count);
+  std::printf("%-3s %8.2f B/uuid %6.2fx vs binary %6.2fx vs text  encode %6.2f GB/s  decode %6.2f GB/s  "
+              "At() %7.1f ns\n",
+              name, bytes_per_uuid, 16.0 / bytes_per_uuid, 36.0 / bytes_per_uuid, raw_bytes / encode / 1e9,
+              raw_bytes / decode / 1e9, lookup / static_cast<double>(probes) * 1e9);
+  g_sink = checksum;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  std::size_t count = 1 << 20;
+  int rounds = 5;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+      count = std::max<std::size_t>(1, std::stoull(argv[++i]));
+    } else if (std::strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+      rounds = std::max(1, std::stoi(argv[++i]));
+    } else {
+      std::fprintf(stderr, "Usage: codec_bench [--count <n>] [--rounds <n>]\n");
+      return 2;
+    }
+  }
+  std::printf("%zu sorted UUIDs per stream, best of %d rounds; GB/s of 16-byte UUIDs\n", count, rounds);
+  vscuuid::UuidV1Generator v1_generator;
+  vscuuid::UuidV6Generator v6_generator;
+  vscuuid::UuidV7Generator v7_generator;
+  Run("v1", v1_generator, count, rounds);
+  Run("v6", v6_generator, count, rounds);
+  Run("v7", v7_generator, count, rounds);
+  return 0;
+}
@@ -0,0 +1,136 @@
+// Hit rate and throughput of NameUuidCache in front of UuidV5Generator when
+// names follow a Zipfian distribution, as repeated lookups of a hot set do.
+// Contention on hot shards only shows with threads on separate cores; run it
+// with --threads at or above the core count, and --shards 1 to put every
+// lookup on one shard's lock.
+//
+//   name_cache_bench [--names <n>] [--ops <n>] [--threads <n>] [--skew <s>] [--shards <n>]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "vscuuid/name_cache.hh"
+#include "vscuuid/uuid_generators.hh"
+
+namespace {
+
+const char* kNamespace = "6ba7b810-9dad-11d1-80b4-00c04fd430c8";
+
+// Keeps the compiler from discarding UUIDs whose results are unused.
+volatile uint8_t g_sink;
+
+struct BenchOptions {
+  std::size_t names = 100000;
+  std::size_t ops = 1000000;
+  unsigned threads = 4;
+  double skew = 0.99;
+  std::size_t shards = 0;
+};
+
+// Samples ranks 0..n-1 with probability proportional to 1 / (rank + 1)^skew
+// by binary search over the cumulative distribution.
+class ZipfSampler {
+ public:
+  ZipfSampler(std::size_t n, double skew) : cdf_(n) {
+    double sum = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      sum += 1.0 / std::pow(static_cast<double>(i + 1), skew);
+      cdf_[i] = sum;
+    }
+    for (double& value : cdf_) {
+      value /= sum;
+    }
+  }
+
+  std::size_t operator()(std::mt19937_64& rng) const {
+    double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    return std::min<std::size_t>(std::lower_bound(cdf_.begin(), cdf_.end(), u) - cdf_.begin(), cdf_.size() - 1);
+  }
+
+ private:
+  std::vector<double> cdf_;
+};
+
+// Runs every thread over its own pre-drawn name sequence and returns
+// millions of UUIDs per second.
+double Run(const BenchOptions& options, const std::vector<std::string>& names,
+           const std::vector<std::vector<uint32_t>>& sequences, std::shared_ptr<vscuuid::NameUuidCache> cache) {
+  std::vector<std::thread> threads;
+  auto begin = std::chrono::steady_clock::now();
+  for (unsigned t = 0; t < options.threads; ++t) {
+    threads.emplace_back([&, t] {
+      vscuuid::UuidV5Generator generator;
+      generator.SetCache(cache);
+      uint8_t checksum = 0;
+      for (uint32_t index : sequences[t]) {
+        checksum ^= generator.GenerateUuid(kNamespace, names[index]).bytes()[0];
+      }
+      g_sink = checksum;
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+  return static_cast<double>(options.ops) / elapsed.count() / 1e6;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  BenchOptions options;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--names") == 0 && i + 1 < argc) {
+      options.names = std::max<std::size_t>(1, std::stoull(argv[++i]));
+    } else if (std::strcmp(argv[i], "--ops") == 0 && i + 1 < argc) {
+      options.ops = std::stoull(argv[++i]);
+    } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      options.threads = std::max(1u, static_cast<unsigned>(std::stoul(argv[++i])));
+    } else if (std::strcmp(argv[i], "--skew") == 0 && i + 1 < argc) {
+      options.skew = std::stod(argv[++i]);
+    } else if (std::strcmp(argv[i], "--shards") == 0 && i + 1 < argc) {
+      options.shards = std::stoull(argv[++i]);
+    } else {
+      std::fprintf(stderr, "Usage: name_cache_bench [--names <n>] [--ops <n>] [--threads <n>] [--skew <s>] [--shards <n>]\n");
+      return 2;
+    }
+  }
+
+  std::vector<std::string> names(options.names);
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    names[i] = "user-" + std::to_string(i) + "@example.com";
+  }
+  ZipfSampler sampler(options.names, options.skew);
+  std::vector<std::vector<uint32_t>> sequences(options.threads);
+  for (unsigned t = 0; t < options.threads; ++t) {
+    std::mt19937_64 rng(t + 1);
+    sequences[t].resize(options.ops / options.threads);
+    for (uint32_t& index : sequences[t]) {
+      index = static_cast<uint32_t>(sampler(rng));
+    }
+  }
+  options.ops = options.ops / options.threads * options.threads;
+
+  std::printf("%zu names, Zipf skew %.2f, %zu lookups on %u threads\n", options.names, options.skew, options.ops,
+              options.threads);
+  std::printf("%-10s %10s %10s %12s\n", "capacity", "hit rate", "Mops/s", "evictions");
+  std::printf("%-10s %10s %10.2f %12s\n", "none", "-", Run(options, names, sequences, nullptr), "-");
+  for (double share : {0.001, 0.01, 0.1}) {
+    std::size_t capacity = std::max<std::size_t>(16, static_cast<std::size_t>(share * options.names));
+    auto cache = std::make_shared<vscuuid::NameUuidCache>(capacity, options.shards);
+    double mops = Run(options, names, sequences, cache);
+    vscuuid::NameCacheStats stats = cache->stats();
+    double hit_rate = static_cast<double>(stats.hits) / static_cast<double>(std::max<uint64_t>(1, stats.hits + stats.misses));
+    std::printf("%-10zu %9.1f%% %10.2f %12llu\n", cache->capacity(), 100.0 * hit_rate, mops,
+                static_cast<unsigned long long>(stats.evictions));
+  }
+  return 0;
+}
@@ -0,0 +1,149 @@
+// Compares the default and per-CPU state backends with many more threads than
+// cores, the case where a shared lock or cache line is passed between threads
+// on every call.
+//
+//   per_cpu_bench [--threads <n>] [--cpus <n>] [--ops <n>]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "vscuuid/clock_sequence_manager.hh"
+#include "vscuuid/entropy_source.hh"
+#include "vscuuid/per_cpu.hh"
+#include "vscuuid/uuid_generators.hh"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+struct BenchOptions {
+  unsigned threads = 256;
+  unsigned cpus = 2;
+  uint64_t ops = 20000;
+};
+
+// Restricts the calling thread to the first `cpus` CPUs it may run on.
+void PinToFirstCpus(unsigned cpus) {
+#if defined(__linux__)
+  cpu_set_t allowed;
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    return;
+  }
+  cpu_set_t pinned;
+  CPU_ZERO(&pinned);
+  unsigned taken = 0;
+  for (int cpu = 0; cpu < CPU_SETSIZE && taken < cpus; ++cpu) {
+    if (CPU_ISSET(cpu, &allowed)) {
+      CPU_SET(cpu, &pinned);
+      ++taken;
+    }
+  }
+  pthread_setaffinity_np(pthread_self(), sizeof(pinned), &pinned);
+#else
+  (void)cpus;
+#endif
+}
+
+template <typename Body>
+double RunThreads(const BenchOptions& options, Body body) {
+  std::atomic<unsigned> ready{0};
+  std::atomic<bool> start{false};
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < options.threads; ++t) {
+    threads.emplace_back([&] {
+      PinToFirstCpus(options.cpus);
+      ready.fetch_add(1);
+      while (!start.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      body(options.ops);
+    });
+  }
+  while (ready.load() < options.threads) {
+    std::this_thread::yield();
+  }
+  auto begin = std::chrono::steady_clock::now();
+  start.store(true, std::memory_order_release);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+  return static_cast<double>(options.threads) * static_cast<double>(options.ops) / elapsed.count() / 1e6;
+}
+
+const char* BackendName(vscuuid::StateBackend backend) {
+  return backend == vscuuid::StateBackend::kPerCpu ? "per-cpu" : "default";
+}
+
+void Report(const char* workload, vscuuid::StateBackend backend, double mops) {
+  std::printf("%-16s %-8s %10.2f Mops/s\n", workload, BackendName(backend), mops);
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  BenchOptions options;
+  options.cpus = std::max(1u, std::min(options.cpus, std::thread::hardware_concurrency()));
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      options.threads = static_cast<unsigned>(std::stoul(argv[++i]));
+    } else if (std::strcmp(argv[i], "--cpus") == 0 && i + 1 < argc) {
+      options.cpus = static_cast<unsigned>(std::stoul(argv[++i]));
+    } else if (std::strcmp(argv[i], "--ops") == 0 && i + 1 < argc) {
+      options.ops = std::stoull(argv[++i]);
+    } else {
+      std::fprintf(stderr, "Usage: per_cpu_bench [--threads <n>] [--cpus <n>] [--ops <n>]\n");
+      return 2;
+    }
+  }
+  std::printf("%u threads on %u CPU(s), %llu ops per thread, per-CPU updates use %s\n", options.threads,
+              options.cpus, static_cast<unsigned long long>(options.ops),
+              vscuuid::PerCpuUsesRseq() ? "rseq" : "atomics");
+
+  const vscuuid::StateBackend backends[] = {vscuuid::StateBackend::kDefault, vscuuid::StateBackend::kPerCpu};
+  for (vscuuid::StateBackend backend : backends) {
+    vscuuid::ClockSequenceManager manager(backend);
+    double mops = RunThreads(options, [&](uint64_t ops) {
+      for (uint64_t i = 0; i < ops; ++i) {
+        manager.GetClockSequence();
+      }
+    });
+    Report("clock sequence", backend, mops);
+  }
+
+  for (vscuuid::StateBackend backend : backends) {
+    vscuuid::UuidV1Generator generator;
+    generator.SetStateBackend(backend);
+    double mops = RunThreads(options, [&](uint64_t ops) {
+      for (uint64_t i = 0; i < ops; ++i) {
+        generator.GenerateUuid();
+      }
+    });
+    Report("v1 uuid", backend, mops);
+  }
+
+  const vscuuid::EntropyOptions original = vscuuid::EntropySource::options();
+  for (vscuuid::StateBackend backend : backends) {
+    vscuuid::EntropyOptions entropy = original;
+    entropy.backend = backend;
+    vscuuid::EntropySource::Configure(entropy);
+    vscuuid::UuidV4Generator generator;
+    double mops = RunThreads(options, [&](uint64_t ops) {
+      for (uint64_t i = 0; i < ops; ++i) {
+        generator.GenerateUuid();
+      }
+    });
+    Report("v4 uuid", backend, mops);
+  }
+  vscuuid::EntropySource::Configure(original);
+  return 0;
+}
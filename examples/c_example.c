@@ -0,0 +1,33 @@
+#include <stdio.h>
+#include "vscuuid/vscuuid_c.h"
+
+#define COUNT 4
+
+int main(void) {
+    vscuuid_generator* generator = NULL;
+    uint8_t uuids[COUNT * VSCUUID_BYTES];
+    char text[COUNT * VSCUUID_STRING_LENGTH];
+    vscuuid_status status;
+    int i;
+
+    // One call per batch instead of one per UUID
+    status = vscuuid_generator_create(7, &generator);
+    if (status == VSCUUID_OK) {
+        status = vscuuid_generate_n(generator, uuids, COUNT);
+    }
+    if (status == VSCUUID_OK) {
+        status = vscuuid_format_n(uuids, COUNT, text, sizeof(text));
+    }
+    vscuuid_generator_destroy(generator);
+
+    if (status != VSCUUID_OK) {
+        fprintf(stderr, "vscuuid error: %s\n", vscuuid_status_string(status));
+        return 1;
+    }
+
+    for (i = 0; i < COUNT; ++i) {
+        printf("Generated UUIDv7: %.36s\n", text + i * VSCUUID_STRING_LENGTH);
+    }
+
+    return 0;
+}
@@ -1,18 +1,28 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <mutex>
+#include "per_cpu.hh"
 
 namespace vscuuid {
 
+class PerCpuCounters;
+
 class ClockSequenceManager {
  public:
-  ClockSequenceManager() = default;
+  explicit ClockSequenceManager(StateBackend backend = StateBackend::kDefault);
+  ~ClockSequenceManager();
 
   uint16_t GetClockSequence();
+  StateBackend backend() const { return backend_; }
 
  private:
+  StateBackend backend_;
   std::mutex mutex_;
   uint16_t last_clock_seq_ = 0;
+  std::unique_ptr<PerCpuCounters> per_cpu_;
+  unsigned shard_bits_ = 0;
 };
 
 }
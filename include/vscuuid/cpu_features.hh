@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string_view>
+
+namespace vscuuid {
+
+// Instruction set tiers the vectorized kernels are built for, in increasing
+// order of capability.
+enum class IsaTier {
+  kScalar,
+  kAvx2,
+  kAvx512,
+};
+
+struct CpuFeatures {
+  bool sse42 = false;
+  bool avx2 = false;
+  bool bmi2 = false;
+  bool avx512f = false;
+  bool avx512bw = false;
+  bool avx512vl = false;
+};
+
+const CpuFeatures& DetectCpuFeatures();
+IsaTier DetectedIsaTier();
+IsaTier ActiveIsaTier();
+IsaTier SetIsaTier(IsaTier tier);
+std::string_view IsaTierName(IsaTier tier);
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "uuid_generator_base.hh"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <span>
+
+namespace vscuuid {
+
+// Maps a stream index to the Unix time in milliseconds stamped into the
+// version 7 UUID at that index. Must be a pure function for the stream to be
+// reproducible.
+using DeterministicClock = std::function<uint64_t(uint64_t index)>;
+
+class DeterministicUuidGenerator : public UuidGeneratorBase {
+ public:
+  // 2024-01-01T00:00:00Z; the default clock advances one millisecond per index.
+  static constexpr uint64_t kDefaultEpochMs = 1704067200000ULL;
+
+  DeterministicUuidGenerator(int version, uint64_t seed, DeterministicClock clock = {});
+  ~DeterministicUuidGenerator() override = default;
+
+  using UuidGeneratorBase::Generate;
+
+  Uuid GenerateUuid() override;
+  void GenerateUuids(std::span<Uuid> out) override;
+
+  Uuid At(uint64_t index) const;
+  void Generate(uint64_t first_index, std::span<Uuid> out) const;
+
+  void Seek(uint64_t index) { position_.store(index, std::memory_order_relaxed); }
+  uint64_t position() const { return position_.load(std::memory_order_relaxed); }
+  uint64_t seed() const { return seed_; }
+  int version() const { return version_; }
+
+ private:
+  int version_;
+  uint64_t seed_;
+  DeterministicClock clock_;
+  std::atomic<uint64_t> position_{0};
+};
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "per_cpu.hh"
+
+namespace vscuuid {
+
+struct EntropyOptions {
+  // Bytes handed out per thread before the key is refreshed from the kernel;
+  // 0 reseeds only on first use and after fork().
+  std::size_t reseed_interval_bytes = std::size_t{1} << 20;
+  // Mix RDSEED/RDRAND output into every reseed when the CPU provides them.
+  bool mix_cpu_entropy = true;
+  // kPerCpu keeps one ChaCha20 key and block counter per CPU instead of a
+  // buffer per thread. Each call then generates its own blocks, so small draws
+  // cost more, but memory and reseeds no longer grow with the thread count.
+  // Each CPU's key is refreshed every reseed_interval_bytes drawn on that CPU
+  // and after fork().
+  StateBackend backend = StateBackend::kDefault;
+};
+
+class EntropySource {
+ public:
+  static void Configure(const EntropyOptions& options);
+  static EntropyOptions options();
+
+  static void Fill(std::span<uint8_t> out);
+  static uint64_t Next64();
+};
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include "vscuuid/uuid.hh"
+
+namespace vscuuid {
+
+struct NameCacheStats {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evictions = 0;
+};
+
+// A bounded cache of name-based UUIDs keyed by (version, namespace, name),
+// shared by any number of V3/V5 generators and threads. Entries are spread
+// over independently locked shards and evicted with the CLOCK policy. A hit
+// takes its shard's lock shared and only sets a reference bit, so lookups of
+// a hot name do not serialize. Keys up to kInlineKeySize bytes are stored
+// inside the entry; longer ones take one allocation when inserted.
+class NameUuidCache {
+ public:
+  static constexpr std::size_t kInlineKeySize = 64;
+
+  explicit NameUuidCache(std::size_t capacity, std::size_t shard_count = 0);
+  ~NameUuidCache();
+
+  NameUuidCache(const NameUuidCache&) = delete;
+  NameUuidCache& operator=(const NameUuidCache&) = delete;
+
+  bool Lookup(int version, std::string_view namespace_uuid, std::string_view name, Uuid* out);
+  void Insert(int version, std::string_view namespace_uuid, std::string_view name, const Uuid& uuid);
+  void Clear();
+
+  std::size_t capacity() const { return shard_count_ * shard_capacity_; }
+  std::size_t shard_count() const { return shard_count_; }
+  NameCacheStats stats() const;
+
+ private:
+  struct Shard;
+
+  Shard& ShardFor(uint64_t hash) const;
+
+  std::size_t shard_count_;
+  std::size_t shard_capacity_;
+  unsigned shard_shift_;
+  std::unique_ptr<Shard[]> shards_;
+};
+
+}
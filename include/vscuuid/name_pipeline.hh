@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include "vscuuid/uuid_factory.hh"
+
+namespace vscuuid {
+
+enum class NameOutputFormat {
+  kText,
+  kBinary,
+};
+
+struct NamePipelineOptions {
+  UuidFactory::UuidType type = UuidFactory::UuidType::V5;
+  NameOutputFormat format = NameOutputFormat::kText;
+  unsigned thread_count = 0;
+  std::size_t batch_bytes = std::size_t{1} << 20;
+  std::size_t max_batches_in_flight = 0;
+};
+
+std::size_t DeriveNameUuids(std::string_view input, std::string_view namespace_uuid,
+                            std::ostream& output, const NamePipelineOptions& options = {});
+std::size_t DeriveNameUuidsFromFile(const std::string& input_path, std::string_view namespace_uuid,
+                                    std::ostream& output, const NamePipelineOptions& options = {});
+
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+namespace vscuuid {
+
+// Where generators keep their mutable state.
+enum class StateBackend {
+  // A mutex-protected clock sequence per generator and ChaCha20 buffers per thread.
+  kDefault,
+  // One cache-line sized slot per CPU, shared by every thread running on it.
+  // Memory and reseed cost scale with the number of CPUs instead of threads.
+  kPerCpu,
+};
+
+bool PerCpuUsesRseq();
+
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <version>
+
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
+
+namespace vscuuid {
+
+inline constexpr std::size_t kUuidStringLength = 36;
+
+class UuidString {
+ public:
+  constexpr UuidString() = default;
+
+  char* data() { return chars_.data(); }
+  const char* data() const { return chars_.data(); }
+  const char* c_str() const { return chars_.data(); }
+  static constexpr std::size_t size() { return kUuidStringLength; }
+
+  std::span<char, kUuidStringLength> span() {
+    return std::span<char, kUuidStringLength>(chars_.data(), kUuidStringLength);
+  }
+  std::string_view view() const { return std::string_view(chars_.data(), kUuidStringLength); }
+  operator std::string_view() const { return view(); }
+  std::string str() const { return std::string(view()); }
+
+  friend bool operator==(const UuidString& lhs, const UuidString& rhs) {
+    return lhs.view() == rhs.view();
+  }
+
+ private:
+  std::array<char, kUuidStringLength + 1> chars_{};
+};
+
+class Uuid {
+ public:
+  constexpr Uuid() = default;
+  constexpr explicit Uuid(const std::array<uint8_t, 16>& bytes) : bytes_(bytes) {}
+
+  static Uuid Parse(std::string_view text);
+  static bool TryParse(std::string_view text, Uuid* out) noexcept;
+
+  const std::array<uint8_t, 16>& bytes() const { return bytes_; }
+  std::array<uint8_t, 16>& bytes() { return bytes_; }
+  int version() const { return bytes_[6] >> 4; }
+  bool is_nil() const { return *this == Uuid(); }
+
+  void FormatTo(std::span<char, kUuidStringLength> out) const noexcept;
+  UuidString ToUuidString() const;
+  std::string ToString() const;
+
+  friend constexpr auto operator<=>(const Uuid&, const Uuid&) = default;
+
+ private:
+  std::array<uint8_t, 16> bytes_{};
+};
+
+std::ostream& operator<<(std::ostream& os, const Uuid& uuid);
+std::ostream& operator<<(std::ostream& os, const UuidString& text);
+
+void FormatUuids(std::span<const Uuid> uuids, std::span<char> out);
+std::size_t ParseUuids(std::span<const char> text, std::span<Uuid> out);
+
+}
+
+template <>
+struct std::hash<vscuuid::Uuid> {
+  std::size_t operator()(const vscuuid::Uuid& uuid) const noexcept {
+    uint64_t hi = 0;
+    uint64_t lo = 0;
+    for (int i = 0; i < 8; ++i) {
+      hi = (hi << 8) | uuid.bytes()[i];
+      lo = (lo << 8) | uuid.bytes()[8 + i];
+    }
+    return static_cast<std::size_t>(hi ^ (lo * 0x9E3779B97F4A7C15ULL));
+  }
+};
+
+#if defined(__cpp_lib_format)
+template <>
+struct std::formatter<vscuuid::Uuid, char> {
+  constexpr auto parse(std::format_parse_context& ctx) { return ctx.begin(); }
+
+  template <typename FormatContext>
+  auto format(const vscuuid::Uuid& uuid, FormatContext& ctx) const {
+    char buffer[vscuuid::kUuidStringLength];
+    uuid.FormatTo(std::span<char, vscuuid::kUuidStringLength>(buffer, vscuuid::kUuidStringLength));
+    return std::copy(buffer, buffer + vscuuid::kUuidStringLength, ctx.out());
+  }
+};
+#endif
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "vscuuid/uuid_generator_base.hh"
+
+namespace vscuuid {
+
+// An executor is any callable that accepts a unit of work and runs it later,
+// e.g. a lambda forwarding to a thread pool's post() or an event loop.
+template <typename Executor>
+concept UuidExecutor = requires(Executor& executor, std::function<void()> work) {
+  executor(std::move(work));
+};
+
+// Awaitable that runs `work` on `executor` and resumes the awaiting coroutine
+// from there. Exceptions thrown by the work are rethrown from co_await.
+template <UuidExecutor Executor, typename Work>
+class ExecutorAwaiter {
+ public:
+  using Result = std::invoke_result_t<Work&>;
+
+  ExecutorAwaiter(Executor& executor, Work work) : executor_(executor), work_(std::move(work)) {}
+
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    executor_([this, handle]() {
+      try {
+        result_.emplace(work_());
+      } catch (...) {
+        error_ = std::current_exception();
+      }
+      handle.resume();
+    });
+  }
+
+  Result await_resume() {
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+    return std::move(*result_);
+  }
+
+ private:
+  Executor& executor_;
+  Work work_;
+  std::optional<Result> result_;
+  std::exception_ptr error_;
+};
+
+// co_await GenerateAsync(generator, executor) yields one Uuid produced on the executor.
+template <UuidExecutor Executor>
+auto GenerateAsync(UuidGeneratorBase& generator, Executor& executor) {
+  auto work = [&generator]() { return generator.GenerateUuid(); };
+  return ExecutorAwaiter<Executor, decltype(work)>(executor, std::move(work));
+}
+
+// co_await GenerateAsync(generator, executor, n) yields n UUIDs produced on the
+// executor through the generator's batch API.
+template <UuidExecutor Executor>
+auto GenerateAsync(UuidGeneratorBase& generator, Executor& executor, std::size_t count) {
+  auto work = [&generator, count]() {
+    std::vector<Uuid> uuids(count);
+    generator.GenerateUuids(uuids);
+    return uuids;
+  };
+  return ExecutorAwaiter<Executor, decltype(work)>(executor, std::move(work));
+}
+
+}
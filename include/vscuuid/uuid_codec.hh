@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "vscuuid/uuid.hh"
+
+namespace vscuuid {
+
+// UUIDs per block; every block but the last holds exactly this many.
+inline constexpr std::size_t kCodecBlockSize = 128;
+
+// A compressed, sorted run of UUIDs. The most significant 64 bits (the
+// timestamp of V6/V7 UUIDs) are delta-encoded and bit-packed per block; the
+// rest is stored raw. A block directory allows decoding any block, or looking
+// up any position, without touching the others.
+class CompressedUuids {
+ public:
+  CompressedUuids() = default;
+
+  static CompressedUuids Encode(std::span<const Uuid> sorted);
+  static CompressedUuids FromBytes(std::span<const uint8_t> bytes);
+
+  std::span<const uint8_t> bytes() const { return bytes_; }
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  std::size_t block_count() const { return (size_ + kCodecBlockSize - 1) / kCodecBlockSize; }
+
+  void Decode(std::span<Uuid> out) const;
+  std::size_t DecodeBlock(std::size_t block, std::span<Uuid> out) const;
+  Uuid At(std::size_t index) const;
+  std::size_t LowerBound(const Uuid& uuid) const;
+  bool Contains(const Uuid& uuid) const;
+
+ private:
+  std::vector<uint8_t> bytes_;
+  std::size_t size_ = 0;
+};
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include "uuid.hh"
+#include "uuid_generator_base.hh"
+
+namespace vscuuid {
+
+// Alignment and padding of every library-allocated column buffer, as
+// recommended by the Arrow columnar format.
+inline constexpr std::size_t kColumnAlignment = 64;
+
+class AlignedBuffer {
+ public:
+  AlignedBuffer() = default;
+  explicit AlignedBuffer(std::size_t size);
+
+  uint8_t* data() { return data_.get(); }
+  const uint8_t* data() const { return data_.get(); }
+  std::size_t size() const { return size_; }
+  std::size_t capacity() const { return capacity_; }
+  bool empty() const { return size_ == 0; }
+  std::span<uint8_t> span() { return std::span<uint8_t>(data_.get(), size_); }
+  std::span<const uint8_t> span() const { return std::span<const uint8_t>(data_.get(), size_); }
+
+ private:
+  struct Deleter {
+    void operator()(uint8_t* data) const;
+  };
+
+  std::unique_ptr<uint8_t, Deleter> data_;
+  std::size_t size_ = 0;
+  std::size_t capacity_ = 0;
+};
+
+// The buffers of an Arrow FixedSizeBinary(16) array: `values` holds length
+// 16-byte UUIDs back to back and `validity` is an LSB-first bitmap, left empty
+// while every slot is valid. Both can be handed to Arrow without copying.
+struct UuidColumn {
+  std::size_t length = 0;
+  std::size_t null_count = 0;
+  AlignedBuffer validity;
+  AlignedBuffer values;
+
+  std::span<const Uuid> uuids() const;
+  bool IsValid(std::size_t index) const;
+  void SetNull(std::size_t index);
+};
+
+// length canonical UUID strings at a fixed stride of kUuidStringLength bytes,
+// without separators or terminators.
+struct UuidTextColumn {
+  std::size_t length = 0;
+  AlignedBuffer chars;
+
+  std::string_view operator[](std::size_t index) const;
+};
+
+UuidColumn GenerateUuidColumn(UuidGeneratorBase& generator, std::size_t length);
+void GenerateUuidColumn(UuidGeneratorBase& generator, std::span<uint8_t> values);
+
+UuidTextColumn FormatUuidColumn(const UuidColumn& column);
+void FormatUuidColumn(std::span<const uint8_t> values, std::span<const uint8_t> validity,
+                      std::span<char> out);
+
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "uuid.hh"
+
+namespace vscuuid {
+
+// Destination columns for ExtractTimeFields(); each must hold at least as many
+// elements as there are UUIDs. A column with an empty span is skipped.
+struct TimeFieldColumns {
+  std::span<uint64_t> timestamps;
+  std::span<uint16_t> clock_sequences;
+  std::span<uint64_t> nodes;
+};
+
+Uuid ConvertV1ToV6(const Uuid& uuid) noexcept;
+Uuid ConvertV6ToV1(const Uuid& uuid) noexcept;
+
+void ConvertV1ToV6(std::span<const Uuid> in, std::span<Uuid> out);
+void ConvertV6ToV1(std::span<const Uuid> in, std::span<Uuid> out);
+
+void ExtractTimeFields(std::span<const Uuid> uuids, const TimeFieldColumns& out);
+
+}
@@ -2,20 +2,35 @@
 
 #include <string>
 #include <memory>
+#include <span>
 #include "vscuuid/clock_sequence_manager.hh"
+#include "vscuuid/uuid.hh"
+#include "vscuuid/uuid_stream.hh"
 
 namespace vscuuid {
 
 class UuidGeneratorBase {
  public:
   virtual ~UuidGeneratorBase() = default;
-  virtual std::string Generate() = 0;
+  virtual Uuid GenerateUuid() = 0;
+  virtual std::string Generate();
+  virtual void GenerateUuids(std::span<Uuid> out);
+
+  UuidStream Stream(std::size_t batch_size = kDefaultStreamBatchSize);
+
+  virtual void SetStateBackend(StateBackend backend);
+
+  void GenerateTo(std::span<char, kUuidStringLength> out);
+  UuidString GenerateString();
 
  protected:
   UuidGeneratorBase();
 
   uint64_t GenerateNodeId();
   uint16_t GetClockSequence();
+  static Uuid MakeUuid(uint64_t time_low, uint64_t time_mid,
+                       uint64_t time_hi_and_version, uint16_t clock_seq,
+                       uint64_t node);
   std::string FormatUuid(uint64_t time_low, uint64_t time_mid,
                          uint64_t time_hi_and_version, uint16_t clock_seq,
                          uint64_t node);
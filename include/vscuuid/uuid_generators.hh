@@ -1,6 +1,12 @@
 #pragma once
 
 #include "uuid_generator_base.hh"
+#include "name_cache.hh"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -11,7 +17,7 @@ class UuidV1Generator : public UuidGeneratorBase {
   UuidV1Generator() = default;
   ~UuidV1Generator() override = default;
 
-  std::string Generate() override;
+  Uuid GenerateUuid() override;
 };
 
 class UuidV2Generator : public UuidGeneratorBase {
@@ -19,7 +25,8 @@ class UuidV2Generator : public UuidGeneratorBase {
   UuidV2Generator();
   ~UuidV2Generator() override = default;
 
-  std::string Generate() override;
+  Uuid GenerateUuid() override;
+  void SetStateBackend(StateBackend backend) override;
 
  private:
   std::shared_ptr<ClockSequenceManager> clock_sequence_manager_;
@@ -31,10 +38,19 @@ class UuidV3Generator : public UuidGeneratorBase {
   UuidV3Generator();
   ~UuidV3Generator() override = default;
 
+  using UuidGeneratorBase::Generate;
+  using UuidGeneratorBase::GenerateString;
+  using UuidGeneratorBase::GenerateTo;
+
+  Uuid GenerateUuid(std::string_view namespace_uuid, std::string_view name);
   std::string Generate(std::string_view namespace_uuid, std::string_view name);
-  std::string Generate() override;
+  void GenerateTo(std::string_view namespace_uuid, std::string_view name,
+                  std::span<char, kUuidStringLength> out);
+  Uuid GenerateUuid() override;
+  void SetCache(std::shared_ptr<NameUuidCache> cache);
 
  private:
+  std::shared_ptr<NameUuidCache> cache_;
   std::string GenerateHash(std::string_view input);
 };
 
@@ -43,7 +59,8 @@ class UuidV4Generator : public UuidGeneratorBase {
   UuidV4Generator();
   ~UuidV4Generator() override = default;
 
-  std::string Generate() override;
+  Uuid GenerateUuid() override;
+  void GenerateUuids(std::span<Uuid> out) override;
 };
 
 class UuidV5Generator : public UuidGeneratorBase {
@@ -51,8 +68,19 @@ class UuidV5Generator : public UuidGeneratorBase {
   UuidV5Generator();
   ~UuidV5Generator() override = default;
 
+  using UuidGeneratorBase::Generate;
+  using UuidGeneratorBase::GenerateString;
+  using UuidGeneratorBase::GenerateTo;
+
+  Uuid GenerateUuid(std::string_view namespace_uuid, std::string_view name);
   std::string Generate(std::string_view namespace_uuid, std::string_view name);
-  std::string Generate() override;
+  void GenerateTo(std::string_view namespace_uuid, std::string_view name,
+                  std::span<char, kUuidStringLength> out);
+  Uuid GenerateUuid() override;
+  void SetCache(std::shared_ptr<NameUuidCache> cache);
+
+ private:
+  std::shared_ptr<NameUuidCache> cache_;
 };
 
 class UuidV6Generator : public UuidGeneratorBase {
@@ -60,7 +88,7 @@ class UuidV6Generator : public UuidGeneratorBase {
   UuidV6Generator();
   ~UuidV6Generator() override = default;
 
-  std::string Generate() override;
+  Uuid GenerateUuid() override;
 };
 
 class UuidV7Generator : public UuidGeneratorBase {
@@ -68,7 +96,15 @@ class UuidV7Generator : public UuidGeneratorBase {
   UuidV7Generator();
   ~UuidV7Generator() override = default;
 
-  std::string Generate() override;
+  Uuid GenerateUuid() override;
+  void SetMonotonic(bool monotonic);
+  bool monotonic() const { return monotonic_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<bool> monotonic_{false};
+  std::mutex mutex_;
+  uint64_t last_timestamp_ = 0;
+  uint16_t counter_ = 0;
 };
 
 class UuidV8Generator : public UuidGeneratorBase {
@@ -76,8 +112,15 @@ class UuidV8Generator : public UuidGeneratorBase {
   UuidV8Generator();
   ~UuidV8Generator() override = default;
 
+  using UuidGeneratorBase::Generate;
+  using UuidGeneratorBase::GenerateString;
+  using UuidGeneratorBase::GenerateTo;
+
+  Uuid GenerateUuid(const std::array<uint8_t, 16>& custom_data);
   std::string Generate(const std::array<uint8_t, 16>& custom_data);
-  std::string Generate() override;
+  void GenerateTo(const std::array<uint8_t, 16>& custom_data,
+                  std::span<char, kUuidStringLength> out);
+  Uuid GenerateUuid() override;
 };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include "vscuuid/uuid.hh"
+
+namespace vscuuid {
+
+class UuidIndex {
+ public:
+  UuidIndex() = default;
+
+  static UuidIndex Build(std::span<const Uuid> uuids);
+  static UuidIndex Open(const std::string& path);
+  void Save(const std::string& path) const;
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  bool Contains(const Uuid& uuid) const;
+  void ContainsBatch(std::span<const Uuid> queries, std::span<bool> results) const;
+
+ private:
+  UuidIndex(std::shared_ptr<const void> storage, const Uuid* slots, std::size_t size)
+      : storage_(std::move(storage)), slots_(slots), size_(size) {}
+
+  std::shared_ptr<const void> storage_;
+  // Eytzinger (BFS) order, 1-based: slots_[0] is padding, children of k are 2k and 2k+1.
+  const Uuid* slots_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+}
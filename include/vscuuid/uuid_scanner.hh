@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include "vscuuid/uuid.hh"
+
+namespace vscuuid {
+
+struct UuidMatch {
+  std::size_t offset;
+  Uuid uuid;
+};
+
+using UuidMatchCallback = std::function<void(const UuidMatch&)>;
+
+std::size_t ScanUuids(std::string_view haystack, const UuidMatchCallback& callback);
+std::size_t ScanUuidsInFile(const std::string& path, const UuidMatchCallback& callback,
+                            unsigned thread_count = 0);
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <vector>
+#include "vscuuid/uuid.hh"
+
+namespace vscuuid {
+
+class UuidGeneratorBase;
+
+inline constexpr std::size_t kDefaultStreamBatchSize = 256;
+
+class UuidStream : public std::ranges::view_interface<UuidStream> {
+ public:
+  class Iterator {
+   public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type = Uuid;
+    using difference_type = std::ptrdiff_t;
+
+    Iterator() = default;
+    explicit Iterator(UuidStream* stream) : stream_(stream) {}
+
+    const Uuid& operator*() const { return stream_->buffer_[stream_->position_]; }
+    Iterator& operator++() {
+      if (++stream_->position_ == stream_->buffer_.size()) {
+        stream_->Refill();
+      }
+      return *this;
+    }
+    void operator++(int) { ++*this; }
+
+   private:
+    UuidStream* stream_ = nullptr;
+  };
+
+  UuidStream(UuidGeneratorBase* generator, std::size_t batch_size);
+  UuidStream(UuidStream&&) noexcept = default;
+  UuidStream& operator=(UuidStream&&) noexcept = default;
+
+  Iterator begin();
+  std::unreachable_sentinel_t end() const { return std::unreachable_sentinel; }
+
+ private:
+  void Refill();
+
+  UuidGeneratorBase* generator_;
+  std::vector<Uuid> buffer_;
+  std::size_t position_ = 0;
+  bool primed_ = false;
+};
+
+}
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include "entropy_source.hh"
+#include "uuid.hh"
+
+namespace vscuuid {
+
+// A string literal usable as a template argument, e.g. Field<"tenant", 20>.
+template <std::size_t N>
+struct FixedString {
+  char chars[N]{};
+
+  constexpr FixedString(const char (&text)[N]) {
+    for (std::size_t i = 0; i < N; ++i) {
+      chars[i] = text[i];
+    }
+  }
+  constexpr std::string_view view() const { return std::string_view(chars, N - 1); }
+};
+
+// A caller-supplied field of Bits bits (1 to 64), addressed by Name.
+template <FixedString Name, unsigned Bits>
+struct Field {
+  static constexpr std::string_view name = Name.view();
+  static constexpr unsigned bits = Bits;
+  static constexpr bool random = false;
+};
+
+// Bits bits (1 to 64) filled from the EntropySource on every pack.
+template <unsigned Bits>
+struct Random {
+  static constexpr std::string_view name{};
+  static constexpr unsigned bits = Bits;
+  static constexpr bool random = true;
+};
+
+// Bits of a version 8 UUID left for custom data once the version (4 bits) and
+// variant (2 bits) are reserved.
+inline constexpr unsigned kV8PayloadBits = 122;
+
+namespace v8_detail {
+
+// The payload is kept as a 128-bit value in two words, filled most significant
+// bit first; it is spread around the version and variant bits only when the
+// UUID is assembled. Every shift below is a compile-time constant.
+template <unsigned kOffset, unsigned kBits>
+inline void Insert(uint64_t value, uint64_t& high, uint64_t& low) {
+  if constexpr (kBits < 64) {
+    value &= (uint64_t{1} << kBits) - 1;
+  }
+  constexpr unsigned kEnd = kOffset + kBits;
+  if constexpr (kEnd <= 64) {
+    high |= value << (64 - kEnd);
+  } else if constexpr (kOffset >= 64) {
+    low |= value << (128 - kEnd);
+  } else {
+    high |= value >> (kEnd - 64);
+    low |= value << (128 - kEnd);
+  }
+}
+
+template <unsigned kOffset, unsigned kBits>
+inline uint64_t Extract(uint64_t high, uint64_t low) {
+  constexpr unsigned kEnd = kOffset + kBits;
+  constexpr uint64_t kMask = kBits == 64 ? ~uint64_t{0} : (uint64_t{1} << kBits) - 1;
+  if constexpr (kEnd <= 64) {
+    return (high >> (64 - kEnd)) & kMask;
+  } else if constexpr (kOffset >= 64) {
+    return (low >> (128 - kEnd)) & kMask;
+  } else {
+    return ((high << (kEnd - 64)) | (low >> (128 - kEnd))) & kMask;
+  }
+}
+
+// Payload bits 0-47 land in UUID bits 0-47, 48-59 in 52-63 and 60-121 in
+// 66-127 (bit 0 being the most significant).
+inline Uuid Assemble(uint64_t high, uint64_t low) {
+  uint64_t uuid_high = (high & 0xFFFFFFFFFFFF0000ULL) | 0x8000 | ((high >> 4) & 0x0FFF);
+  uint64_t uuid_low = 0x8000000000000000ULL | ((high & 0xF) << 58) | (low >> 6);
+  std::array<uint8_t, 16> bytes;
+  for (int i = 0; i < 8; ++i) {
+    bytes[i] = static_cast<uint8_t>(uuid_high >> (56 - 8 * i));
+    bytes[8 + i] = static_cast<uint8_t>(uuid_low >> (56 - 8 * i));
+  }
+  return Uuid(bytes);
+}
+
+inline void Disassemble(const Uuid& uuid, uint64_t& high, uint64_t& low) {
+  uint64_t uuid_high = 0;
+  uint64_t uuid_low = 0;
+  for (int i = 0; i < 8; ++i) {
+    uuid_high = (uuid_high << 8) | uuid.bytes()[i];
+    uuid_low = (uuid_low << 8) | uuid.bytes()[8 + i];
+  }
+  high = (uuid_high & 0xFFFFFFFFFFFF0000ULL) | ((uuid_high & 0x0FFF) << 4) | ((uuid_low >> 58) & 0xF);
+  low = uuid_low << 6;
+}
+
+}
+
+/**
+ * @brief A compile-time description of the custom bits of a version 8 UUID.
+ *
+ * Fields are laid out in declaration order from the most significant bit,
+ * skipping the version and variant bits, so a leading timestamp field keeps
+ * UUIDs sortable. Pack() and Get() compile to a fixed sequence of shifts and
+ * masks; values wider than their field are truncated.
+ *
+ *   using OrderId = V8Layout<Field<"tenant", 20>, Field<"ts_ms", 48>, Random<54>>;
+ *   Uuid id = OrderId::Pack(tenant, now_ms);
+ *   uint64_t t = OrderId::Get<"tenant">(id);
+ */
+template <typename... Fields>
+class V8Layout {
+ public:
+  static constexpr std::size_t kFieldCount = sizeof...(Fields);
+  static constexpr unsigned kPayloadBits = (Fields::bits + ... + 0);
+  static constexpr std::size_t kValueCount = ((Fields::random ? 0 : 1) + ... + 0);
+  static constexpr std::size_t kRandomCount = kFieldCount - kValueCount;
+
+  static_assert(kFieldCount > 0, "A V8 layout needs at least one field");
+  static_assert(((Fields::bits >= 1 && Fields::bits <= 64) && ...), "V8 fields must be 1 to 64 bits wide");
+  static_assert(kPayloadBits <= kV8PayloadBits,
+                "V8 fields exceed the 122 bits left around the version and variant");
+
+  template <FixedString Name>
+  static constexpr std::size_t IndexOf() {
+    constexpr std::size_t index = Find(Name.view());
+    static_assert(index < kFieldCount, "No field with this name in the V8 layout");
+    return index;
+  }
+
+  template <typename... Values>
+  static Uuid Pack(Values... values) {
+    static_assert(sizeof...(Values) == kValueCount, "Pack takes one value per named field, in order");
+    const uint64_t named[kValueCount + 1] = {static_cast<uint64_t>(values)...};
+    uint64_t random[kRandomCount + 1] = {};
+    if constexpr (kRandomCount > 0) {
+      EntropySource::Fill(std::span<uint8_t>(reinterpret_cast<uint8_t*>(random), kRandomCount * sizeof(uint64_t)));
+    }
+    return PackWords(named, random);
+  }
+
+  template <FixedString Name>
+  static uint64_t Get(const Uuid& uuid) {
+    constexpr std::size_t kIndex = IndexOf<Name>();
+    uint64_t high;
+    uint64_t low;
+    v8_detail::Disassemble(uuid, high, low);
+    return v8_detail::Extract<kOffsets[kIndex], kBits[kIndex]>(high, low);
+  }
+
+  // Packs out.size() UUIDs from struct-of-arrays input: one column per named
+  // field, in declaration order. Random fields are drawn in bulk.
+  template <typename... Columns>
+  static void PackBatch(std::span<Uuid> out, Columns... columns) {
+    static_assert(sizeof...(Columns) == kValueCount, "PackBatch takes one column per named field, in order");
+    const std::array<std::span<const uint64_t>, kValueCount + 1> spans = {std::span<const uint64_t>(columns)...};
+    for (std::size_t c = 0; c < kValueCount; ++c) {
+      if (spans[c].size() < out.size()) {
+        throw std::invalid_argument("V8 layout column is shorter than the output");
+      }
+    }
+    constexpr std::size_t kChunk = 256;
+    uint64_t random[kChunk * kRandomCount + 1] = {};
+    for (std::size_t begin = 0; begin < out.size(); begin += kChunk) {
+      std::size_t count = std::min(kChunk, out.size() - begin);
+      if constexpr (kRandomCount > 0) {
+        EntropySource::Fill(std::span<uint8_t>(reinterpret_cast<uint8_t*>(random),
+                                               count * kRandomCount * sizeof(uint64_t)));
+      }
+      for (std::size_t i = 0; i < count; ++i) {
+        uint64_t named[kValueCount + 1];
+        for (std::size_t c = 0; c < kValueCount; ++c) {
+          named[c] = spans[c][begin + i];
+        }
+        out[begin + i] = PackWords(named, random + i * kRandomCount);
+      }
+    }
+  }
+
+  template <FixedString Name>
+  static void GetBatch(std::span<const Uuid> in, std::span<uint64_t> out) {
+    if (out.size() < in.size()) {
+      throw std::invalid_argument("Output span is smaller than the input span");
+    }
+    for (std::size_t i = 0; i < in.size(); ++i) {
+      out[i] = Get<Name>(in[i]);
+    }
+  }
+
+ private:
+  static constexpr std::array<unsigned, kFieldCount> kBits = {Fields::bits...};
+  static constexpr std::array<bool, kFieldCount> kRandom = {Fields::random...};
+  static constexpr std::array<std::string_view, kFieldCount> kNames = {Fields::name...};
+
+  static constexpr std::array<unsigned, kFieldCount> MakeOffsets() {
+    std::array<unsigned, kFieldCount> offsets{};
+    unsigned offset = 0;
+    for (std::size_t i = 0; i < kFieldCount; ++i) {
+      offsets[i] = offset;
+      offset += kBits[i];
+    }
+    return offsets;
+  }
+  static constexpr std::array<unsigned, kFieldCount> kOffsets = MakeOffsets();
+
+  // Position of field i among the named fields, or among the random fields.
+  static constexpr std::size_t SourceIndex(std::size_t field) {
+    std::size_t index = 0;
+    for (std::size_t i = 0; i < field; ++i) {
+      index += kRandom[i] == kRandom[field] ? 1 : 0;
+    }
+    return index;
+  }
+
+  static constexpr std::size_t Find(std::string_view name) {
+    for (std::size_t i = 0; i < kFieldCount; ++i) {
+      if (!kRandom[i] && kNames[i] == name) {
+        return i;
+      }
+    }
+    return kFieldCount;
+  }
+
+  static constexpr bool NamesUnique() {
+    for (std::size_t i = 0; i < kFieldCount; ++i) {
+      for (std::size_t j = i + 1; j < kFieldCount; ++j) {
+        if (!kRandom[i] && !kRandom[j] && kNames[i] == kNames[j]) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+  static_assert(NamesUnique(), "V8 layout field names must be unique");
+
+  template <std::size_t I>
+  static void InsertField(const uint64_t* named, const uint64_t* random, uint64_t& high, uint64_t& low) {
+    const uint64_t value = kRandom[I] ? random[SourceIndex(I)] : named[SourceIndex(I)];
+    v8_detail::Insert<kOffsets[I], kBits[I]>(value, high, low);
+  }
+
+  static Uuid PackWords(const uint64_t* named, const uint64_t* random) {
+    uint64_t high = 0;
+    uint64_t low = 0;
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      (InsertField<I>(named, random, high, low), ...);
+    }(std::make_index_sequence<kFieldCount>{});
+    return v8_detail::Assemble(high, low);
+  }
+};
+
+}
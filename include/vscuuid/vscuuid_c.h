@@ -0,0 +1,80 @@
+#ifndef VSCUUID_VSCUUID_C_H_
+#define VSCUUID_VSCUUID_C_H_
+
+/*
+ * Stable C interface to vscuuid for FFI consumers.
+ *
+ * UUIDs cross the boundary as 16 raw bytes in network order, text as
+ * back-to-back 36 character records without terminators. Every call takes
+ * caller-owned buffers so one crossing can cover any number of values; no
+ * function allocates memory the caller has to free, except the generator
+ * handle itself. Errors are reported as vscuuid_status codes, never as C++
+ * exceptions.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(VSCUUID_C_BUILDING)
+#define VSCUUID_C_API __declspec(dllexport)
+#else
+#define VSCUUID_C_API __declspec(dllimport)
+#endif
+#elif defined(__GNUC__) || defined(__clang__)
+#define VSCUUID_C_API __attribute__((visibility("default")))
+#else
+#define VSCUUID_C_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Incremented whenever a function is added; existing signatures never change. */
+#define VSCUUID_C_ABI_VERSION 1
+
+#define VSCUUID_BYTES 16
+#define VSCUUID_STRING_LENGTH 36
+
+typedef enum vscuuid_status {
+  VSCUUID_OK = 0,
+  VSCUUID_ERROR_INVALID_ARGUMENT = 1,
+  VSCUUID_ERROR_BUFFER_TOO_SMALL = 2,
+  VSCUUID_ERROR_PARSE = 3,
+  VSCUUID_ERROR_OUT_OF_MEMORY = 4,
+  VSCUUID_ERROR_INTERNAL = 5
+} vscuuid_status;
+
+/* Opaque generator handle. A handle must not be used by two threads at once. */
+typedef struct vscuuid_generator vscuuid_generator;
+
+VSCUUID_C_API int vscuuid_abi_version(void);
+VSCUUID_C_API const char* vscuuid_status_string(vscuuid_status status);
+
+/* version is 1 to 8. */
+VSCUUID_C_API vscuuid_status vscuuid_generator_create(int version, vscuuid_generator** out);
+VSCUUID_C_API void vscuuid_generator_destroy(vscuuid_generator* generator);
+
+/* Writes n UUIDs (16 * n bytes) to out. */
+VSCUUID_C_API vscuuid_status vscuuid_generate_n(vscuuid_generator* generator, uint8_t* out, size_t n);
+
+/* Version 3 and 5 handles only. namespace_uuid is NUL-terminated text; names[i]
+ * holds name_lengths[i] bytes. Writes n UUIDs (16 * n bytes) to out. */
+VSCUUID_C_API vscuuid_status vscuuid_generate_names_n(vscuuid_generator* generator, const char* namespace_uuid,
+                                                     const char* const* names, const size_t* name_lengths,
+                                                     size_t n, uint8_t* out);
+
+/* Formats n UUIDs into 36 * n characters; out_size is the capacity of out. */
+VSCUUID_C_API vscuuid_status vscuuid_format_n(const uint8_t* uuids, size_t n, char* out, size_t out_size);
+
+/* Parses n records of 36 characters into 16 * n bytes. On VSCUUID_ERROR_PARSE,
+ * *parsed (if not NULL) is the index of the first malformed record and all
+ * records before it have been written. */
+VSCUUID_C_API vscuuid_status vscuuid_parse_n(const char* text, size_t n, uint8_t* out, size_t* parsed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace vscuuid {
+
+inline constexpr std::size_t kChaChaBlockSize = 64;
+
+inline uint32_t RotateLeft32(uint32_t value, int count) {
+  return (value << count) | (value >> (32 - count));
+}
+
+inline void ChaChaQuarterRound(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d) {
+  a += b; d ^= a; d = RotateLeft32(d, 16);
+  c += d; b ^= c; b = RotateLeft32(b, 12);
+  a += b; d ^= a; d = RotateLeft32(d, 8);
+  c += d; b ^= c; b = RotateLeft32(b, 7);
+}
+
+/**
+ * @brief Writes `blocks` consecutive ChaCha20 keystream blocks.
+ *
+ * Uses the original 64-bit block counter / 64-bit nonce layout. Output words
+ * are serialized little-endian as the specification requires, so the stream
+ * is identical on every host.
+ */
+inline void ChaCha20Blocks(const uint32_t key[8], uint64_t nonce, uint64_t counter,
+                           uint8_t* out, std::size_t blocks) {
+  for (std::size_t b = 0; b < blocks; ++b, ++counter) {
+    const uint32_t input[16] = {
+        0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+        key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+        static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32),
+        static_cast<uint32_t>(nonce), static_cast<uint32_t>(nonce >> 32)};
+    uint32_t x[16];
+    std::memcpy(x, input, sizeof(x));
+    for (int round = 0; round < 10; ++round) {
+      ChaChaQuarterRound(x[0], x[4], x[8], x[12]);
+      ChaChaQuarterRound(x[1], x[5], x[9], x[13]);
+      ChaChaQuarterRound(x[2], x[6], x[10], x[14]);
+      ChaChaQuarterRound(x[3], x[7], x[11], x[15]);
+      ChaChaQuarterRound(x[0], x[5], x[10], x[15]);
+      ChaChaQuarterRound(x[1], x[6], x[11], x[12]);
+      ChaChaQuarterRound(x[2], x[7], x[8], x[13]);
+      ChaChaQuarterRound(x[3], x[4], x[9], x[14]);
+    }
+    for (int i = 0; i < 16; ++i) {
+      uint32_t word = x[i] + input[i];
+      out[4 * i] = static_cast<uint8_t>(word);
+      out[4 * i + 1] = static_cast<uint8_t>(word >> 8);
+      out[4 * i + 2] = static_cast<uint8_t>(word >> 16);
+      out[4 * i + 3] = static_cast<uint8_t>(word >> 24);
+    }
+    out += kChaChaBlockSize;
+  }
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+
+/**
+ * @brief Generates kLanes ChaCha20 blocks at once, one block per vector lane.
+ *
+ * V is a GCC/Clang vector of kLanes uint32_t. The function is force-inlined so
+ * that it is compiled with the ISA of the caller (an AVX2 or AVX-512 kernel);
+ * the output is byte-identical to ChaCha20Blocks().
+ */
+template <typename V, std::size_t kLanes>
+__attribute__((always_inline)) inline void ChaCha20VectorBlocks(const uint32_t key[8], uint64_t nonce,
+                                                                uint64_t counter, uint8_t* out) {
+  static_assert(sizeof(V) == kLanes * sizeof(uint32_t), "vector type must hold kLanes words");
+  // Zeroed up front: the counter rows are filled lane by lane, which GCC
+  // otherwise reports as -Wmaybe-uninitialized at -O2.
+  V input[16] = {};
+  const uint32_t constants[4] = {0x61707865, 0x3320646e, 0x79622d32, 0x6b206574};
+  for (int i = 0; i < 4; ++i) {
+    input[i] = V{} + constants[i];
+  }
+  for (int i = 0; i < 8; ++i) {
+    input[4 + i] = V{} + key[i];
+  }
+  for (std::size_t lane = 0; lane < kLanes; ++lane) {
+    input[12][lane] = static_cast<uint32_t>(counter + lane);
+    input[13][lane] = static_cast<uint32_t>((counter + lane) >> 32);
+  }
+  input[14] = V{} + static_cast<uint32_t>(nonce);
+  input[15] = V{} + static_cast<uint32_t>(nonce >> 32);
+
+  V x[16];
+  for (int i = 0; i < 16; ++i) {
+    x[i] = input[i];
+  }
+  // A macro rather than a lambda: a lambda would be compiled for the baseline
+  // ISA instead of the caller's.
+#define VSCUUID_CHACHA_VECTOR_QR(a, b, c, d)       \
+  a += b; d ^= a; d = (d << 16) | (d >> 16);       \
+  c += d; b ^= c; b = (b << 12) | (b >> 20);       \
+  a += b; d ^= a; d = (d << 8) | (d >> 24);        \
+  c += d; b ^= c; b = (b << 7) | (b >> 25)
+  for (int round = 0; round < 10; ++round) {
+    VSCUUID_CHACHA_VECTOR_QR(x[0], x[4], x[8], x[12]);
+    VSCUUID_CHACHA_VECTOR_QR(x[1], x[5], x[9], x[13]);
+    VSCUUID_CHACHA_VECTOR_QR(x[2], x[6], x[10], x[14]);
+    VSCUUID_CHACHA_VECTOR_QR(x[3], x[7], x[11], x[15]);
+    VSCUUID_CHACHA_VECTOR_QR(x[0], x[5], x[10], x[15]);
+    VSCUUID_CHACHA_VECTOR_QR(x[1], x[6], x[11], x[12]);
+    VSCUUID_CHACHA_VECTOR_QR(x[2], x[7], x[8], x[13]);
+    VSCUUID_CHACHA_VECTOR_QR(x[3], x[4], x[9], x[14]);
+  }
+#undef VSCUUID_CHACHA_VECTOR_QR
+
+  uint32_t words[16][kLanes];
+  for (int i = 0; i < 16; ++i) {
+    V sum = x[i] + input[i];
+    std::memcpy(words[i], &sum, sizeof(sum));
+  }
+  for (std::size_t lane = 0; lane < kLanes; ++lane) {
+    uint8_t* block = out + lane * kChaChaBlockSize;
+    for (int i = 0; i < 16; ++i) {
+      uint32_t word = words[i][lane];
+      block[4 * i] = static_cast<uint8_t>(word);
+      block[4 * i + 1] = static_cast<uint8_t>(word >> 8);
+      block[4 * i + 2] = static_cast<uint8_t>(word >> 16);
+      block[4 * i + 3] = static_cast<uint8_t>(word >> 24);
+    }
+  }
+}
+
+#endif
+
+}
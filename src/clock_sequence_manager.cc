@@ -1,7 +1,33 @@
 #include "vscuuid/clock_sequence_manager.hh"
+#include "per_cpu_counters.hh"
 
 namespace vscuuid {
 
+namespace {
+
+// At most 2^8 CPU shards, leaving at least 6 bits of counter per shard. The
+// counters are capped to as many slots, so every slot gets its own shard.
+constexpr unsigned kMaxShardBits = 8;
+
+}
+
+/**
+ * @brief Creates a clock sequence source.
+ *
+ * @param backend kDefault hands out consecutive values under a mutex;
+ *        kPerCpu gives every CPU its own counter.
+ */
+ClockSequenceManager::ClockSequenceManager(StateBackend backend) : backend_(backend) {
+  if (backend_ == StateBackend::kPerCpu) {
+    per_cpu_ = std::make_unique<PerCpuCounters>(std::size_t{1} << kMaxShardBits);
+    while (shard_bits_ < kMaxShardBits && (std::size_t{1} << shard_bits_) < per_cpu_->slot_count()) {
+      ++shard_bits_;
+    }
+  }
+}
+
+ClockSequenceManager::~ClockSequenceManager() = default;
+
 /**
  * @brief Retrieves the current clock sequence value.
  *
@@ -10,9 +36,22 @@ namespace vscuuid {
  * with each call, and if it reaches the maximum value (0x3FFF), it wraps around
  * to 0.
  *
+ * With the per-CPU backend the CPU's slot index fills the low bits and its own
+ * counter the rest, so CPUs never contend for a lock or cache line. Each slot
+ * cycles through 2^(14 - shard bits) values, as few as 64 with 256 slots, and
+ * no two slots share a value. When the possible CPU ids do not fit in 256
+ * slots, CPUs share slots and update them atomically instead of through
+ * restartable sequences.
+ *
  * @return The current clock sequence value, masked to 14 bits.
  */
 uint16_t ClockSequenceManager::GetClockSequence() {
+  if (per_cpu_) {
+    std::size_t slot;
+    uint64_t count = per_cpu_->FetchAdd(1, &slot);
+    uint64_t shard = slot & ((uint64_t{1} << shard_bits_) - 1);
+    return static_cast<uint16_t>(((count << shard_bits_) | shard) & 0x3FFF);
+  }
   std::lock_guard<std::mutex> lock(mutex_);
   if (last_clock_seq_ == 0x3FFF) {
     last_clock_seq_ = 0;
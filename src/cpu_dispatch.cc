@@ -0,0 +1,157 @@
+#include "cpu_dispatch.hh"
+
+#include <atomic>
+#include <cstdlib>
+#include <string_view>
+
+namespace vscuuid {
+
+namespace {
+
+const kernels::KernelTable kScalarTable = {
+    IsaTier::kScalar, kernels::FormatScalar, kernels::ParseScalar, kernels::ScanScalar,
+    kernels::ChaCha20Scalar, kernels::ConvertV1ToV6Scalar, kernels::ConvertV6ToV1Scalar};
+
+#if defined(VSCUUID_X86_KERNELS)
+const kernels::KernelTable kAvx2Table = {
+    IsaTier::kAvx2, kernels::FormatAvx2, kernels::ParseAvx2, kernels::ScanAvx2,
+    kernels::ChaCha20Avx2, kernels::ConvertV1ToV6Avx2, kernels::ConvertV6ToV1Avx2};
+
+const kernels::KernelTable kAvx512Table = {
+    IsaTier::kAvx512, kernels::FormatAvx512, kernels::ParseAvx512, kernels::ScanAvx512,
+    kernels::ChaCha20Avx512, kernels::ConvertV1ToV6Avx512, kernels::ConvertV6ToV1Avx512};
+#endif
+
+CpuFeatures Probe() {
+  CpuFeatures features;
+#if defined(VSCUUID_X86_KERNELS)
+  // __builtin_cpu_supports also checks that the OS saves the wide register
+  // state, so a feature reported here is actually usable.
+  __builtin_cpu_init();
+  features.sse42 = __builtin_cpu_supports("sse4.2");
+  features.avx2 = __builtin_cpu_supports("avx2");
+  features.bmi2 = __builtin_cpu_supports("bmi2");
+  features.avx512f = __builtin_cpu_supports("avx512f");
+  features.avx512bw = __builtin_cpu_supports("avx512bw");
+  features.avx512vl = __builtin_cpu_supports("avx512vl");
+#endif
+  return features;
+}
+
+const kernels::KernelTable& TableFor(IsaTier tier) {
+#if defined(VSCUUID_X86_KERNELS)
+  switch (tier) {
+    case IsaTier::kAvx512:
+      return kAvx512Table;
+    case IsaTier::kAvx2:
+      return kAvx2Table;
+    case IsaTier::kScalar:
+      break;
+  }
+#else
+  (void)tier;
+#endif
+  return kScalarTable;
+}
+
+IsaTier ClampTier(IsaTier tier) {
+  return tier < DetectedIsaTier() ? tier : DetectedIsaTier();
+}
+
+// VSCUUID_ISA=scalar|avx2|avx512 caps the tier chosen at startup, which makes
+// it possible to benchmark or debug the narrower kernels on a wide machine.
+IsaTier InitialTier() {
+  IsaTier tier = DetectedIsaTier();
+  if (const char* env = std::getenv("VSCUUID_ISA")) {
+    std::string_view name(env);
+    for (IsaTier candidate : {IsaTier::kScalar, IsaTier::kAvx2, IsaTier::kAvx512}) {
+      if (name == IsaTierName(candidate)) {
+        tier = ClampTier(candidate);
+      }
+    }
+  }
+  return tier;
+}
+
+std::atomic<const kernels::KernelTable*>& ActiveSlot() {
+  static std::atomic<const kernels::KernelTable*> slot{&TableFor(InitialTier())};
+  return slot;
+}
+
+}
+
+/**
+ * @brief Returns the instruction set extensions available to this process.
+ *
+ * Detected once; features the operating system does not enable are reported
+ * as absent.
+ */
+const CpuFeatures& DetectCpuFeatures() {
+  static const CpuFeatures features = Probe();
+  return features;
+}
+
+/**
+ * @brief Returns the widest kernel tier this CPU can run.
+ */
+IsaTier DetectedIsaTier() {
+  const CpuFeatures& features = DetectCpuFeatures();
+  if (features.avx512f && features.avx512bw && features.avx2) {
+    return IsaTier::kAvx512;
+  }
+  if (features.avx2) {
+    return IsaTier::kAvx2;
+  }
+  return IsaTier::kScalar;
+}
+
+/**
+ * @brief Returns the tier whose kernels are currently in use.
+ */
+IsaTier ActiveIsaTier() {
+  return kernels::Active().tier;
+}
+
+/**
+ * @brief Selects the kernel tier used by formatting, parsing, scanning and the
+ * entropy source.
+ *
+ * Requests above DetectedIsaTier() are clamped to it. Switching is safe while
+ * other threads are running kernels: each call picks up one complete table.
+ *
+ * @param tier The requested tier.
+ * @return The tier that is now active.
+ */
+IsaTier SetIsaTier(IsaTier tier) {
+  const kernels::KernelTable& table = TableFor(ClampTier(tier));
+  ActiveSlot().store(&table, std::memory_order_release);
+  return table.tier;
+}
+
+/**
+ * @brief Returns the lower-case name of a tier, as accepted by VSCUUID_ISA.
+ */
+std::string_view IsaTierName(IsaTier tier) {
+  switch (tier) {
+    case IsaTier::kAvx512:
+      return "avx512";
+    case IsaTier::kAvx2:
+      return "avx2";
+    case IsaTier::kScalar:
+      break;
+  }
+  return "scalar";
+}
+
+namespace kernels {
+
+/**
+ * @brief Returns the kernel table for the active tier.
+ */
+const KernelTable& Active() {
+  return *ActiveSlot().load(std::memory_order_acquire);
+}
+
+}
+
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "kernels.hh"
+#include "vscuuid/cpu_features.hh"
+
+namespace vscuuid {
+namespace kernels {
+
+struct KernelTable {
+  IsaTier tier;
+  FormatKernel format;
+  ParseKernel parse;
+  ScanKernel scan;
+  ChaChaKernel chacha20;
+  ConvertKernel convert_v1_to_v6;
+  ConvertKernel convert_v6_to_v1;
+};
+
+const KernelTable& Active();
+
+}
+}
@@ -0,0 +1,92 @@
+#include "vscuuid/deterministic_generator.hh"
+#include "philox.hh"
+
+#include <stdexcept>
+#include <utility>
+
+namespace vscuuid {
+
+/**
+ * @brief Creates a reproducible generator for version 4, 7 or 8 UUIDs.
+ *
+ * The UUID at index i is a pure function of (seed, i): its random bits are the
+ * Philox4x32-10 output for counter i under key seed. Any index range can be
+ * produced independently, so parallel workers splitting a range between them
+ * produce exactly the stream a single thread would.
+ *
+ * @param version 4, 7 or 8.
+ * @param seed The stream seed.
+ * @param clock For version 7, maps an index to its Unix millisecond timestamp.
+ *        Defaults to kDefaultEpochMs + index. Ignored for other versions.
+ * @throws std::invalid_argument if the version is not 4, 7 or 8.
+ */
+DeterministicUuidGenerator::DeterministicUuidGenerator(int version, uint64_t seed, DeterministicClock clock)
+    : version_(version), seed_(seed), clock_(std::move(clock)) {
+  if (version != 4 && version != 7 && version != 8) {
+    throw std::invalid_argument("Deterministic generation supports versions 4, 7 and 8");
+  }
+  if (!clock_) {
+    clock_ = [](uint64_t index) { return kDefaultEpochMs + index; };
+  }
+}
+
+/**
+ * @brief Returns the UUID at the current position and advances by one.
+ *
+ * Concurrent callers each receive a distinct index.
+ */
+Uuid DeterministicUuidGenerator::GenerateUuid() {
+  return At(position_.fetch_add(1, std::memory_order_relaxed));
+}
+
+/**
+ * @brief Fills out with the UUIDs at the current position and advances past them.
+ */
+void DeterministicUuidGenerator::GenerateUuids(std::span<Uuid> out) {
+  Generate(position_.fetch_add(out.size(), std::memory_order_relaxed), out);
+}
+
+/**
+ * @brief Returns the UUID at an arbitrary index without changing the position.
+ *
+ * @param index The stream index.
+ * @return The UUID at that index.
+ */
+Uuid DeterministicUuidGenerator::At(uint64_t index) const {
+  const std::array<uint32_t, 2> key = {static_cast<uint32_t>(seed_), static_cast<uint32_t>(seed_ >> 32)};
+  const std::array<uint32_t, 4> words =
+      Philox4x32({static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32), 0, 0}, key);
+
+  std::array<uint8_t, 16> bytes;
+  for (int i = 0; i < 4; ++i) {
+    bytes[4 * i] = static_cast<uint8_t>(words[i] >> 24);
+    bytes[4 * i + 1] = static_cast<uint8_t>(words[i] >> 16);
+    bytes[4 * i + 2] = static_cast<uint8_t>(words[i] >> 8);
+    bytes[4 * i + 3] = static_cast<uint8_t>(words[i]);
+  }
+  if (version_ == 7) {
+    uint64_t ms = clock_(index);
+    for (int i = 0; i < 6; ++i) {
+      bytes[i] = static_cast<uint8_t>(ms >> (8 * (5 - i)));
+    }
+  }
+  bytes[6] = static_cast<uint8_t>((bytes[6] & 0x0F) | (version_ << 4));
+  bytes[8] = static_cast<uint8_t>((bytes[8] & 0x3F) | 0x80);
+  return Uuid(bytes);
+}
+
+/**
+ * @brief Fills out with the UUIDs at first_index, first_index + 1, ...
+ *
+ * Does not change the position; safe to call from several threads at once.
+ *
+ * @param first_index The index of out[0].
+ * @param out The destination.
+ */
+void DeterministicUuidGenerator::Generate(uint64_t first_index, std::span<Uuid> out) const {
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    out[i] = At(first_index + i);
+  }
+}
+
+}
@@ -0,0 +1,450 @@
+#include "vscuuid/entropy_source.hh"
+#include "chacha20.hh"
+#include "cpu_dispatch.hh"
+#include "per_cpu_counters.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <random>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <sys/random.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__)
+#include <unistd.h>
+#define VSCUUID_HAVE_GETENTROPY 1
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <sys/mman.h>
+#define VSCUUID_HAVE_ATFORK 1
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <immintrin.h>
+#define VSCUUID_HAVE_CPU_RNG 1
+#endif
+
+namespace vscuuid {
+
+namespace {
+
+constexpr std::size_t kRefillBlocks = 16;
+constexpr std::size_t kBufferSize = kRefillBlocks * kChaChaBlockSize;
+constexpr std::size_t kKeySize = 32;
+
+std::atomic<std::size_t> g_reseed_interval{EntropyOptions().reseed_interval_bytes};
+std::atomic<bool> g_mix_cpu_entropy{EntropyOptions().mix_cpu_entropy};
+std::atomic<StateBackend> g_backend{EntropyOptions().backend};
+std::atomic<uint64_t> g_fork_generation{0};
+// Lives in a MADV_WIPEONFORK page: the kernel zeroes it in every child, which
+// catches forks that bypass pthread_atfork (raw clone, vfork-like wrappers).
+std::atomic<uint64_t>* g_fork_canary = nullptr;
+
+struct ThreadState {
+  uint32_t key[8];
+  uint64_t nonce;
+  uint64_t counter;
+  std::size_t position = kBufferSize;
+  std::size_t since_reseed = 0;
+  uint64_t fork_generation = 0;
+  bool seeded = false;
+  alignas(64) uint8_t buffer[kBufferSize];
+};
+
+thread_local ThreadState t_state;
+
+void OnForkChild() {
+  g_fork_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+void InstallForkDetection() {
+  static std::once_flag once;
+  std::call_once(once, [] {
+#if defined(VSCUUID_HAVE_ATFORK)
+    pthread_atfork(nullptr, nullptr, OnForkChild);
+#if defined(MADV_WIPEONFORK)
+    void* page = ::mmap(nullptr, 4096, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (page != MAP_FAILED) {
+      if (::madvise(page, 4096, MADV_WIPEONFORK) == 0) {
+        g_fork_canary = new (page) std::atomic<uint64_t>(1);
+      } else {
+        ::munmap(page, 4096);
+      }
+    }
+#endif
+#endif
+  });
+}
+
+uint64_t CurrentForkGeneration() {
+  if (g_fork_canary != nullptr && g_fork_canary->load(std::memory_order_relaxed) == 0) {
+    g_fork_canary->store(1, std::memory_order_relaxed);
+    g_fork_generation.fetch_add(1, std::memory_order_relaxed);
+  }
+  return g_fork_generation.load(std::memory_order_relaxed);
+}
+
+void ReadOsEntropy(uint8_t* out, std::size_t size) {
+#if defined(__linux__)
+  while (size > 0) {
+    ssize_t got = ::getrandom(out, size, 0);
+    if (got < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error("getrandom failed");
+    }
+    out += got;
+    size -= static_cast<std::size_t>(got);
+  }
+#elif defined(VSCUUID_HAVE_GETENTROPY)
+  while (size > 0) {
+    std::size_t chunk = std::min<std::size_t>(size, 256);
+    if (::getentropy(out, chunk) != 0) {
+      throw std::runtime_error("getentropy failed");
+    }
+    out += chunk;
+    size -= chunk;
+  }
+#else
+  std::random_device rd;
+  for (std::size_t i = 0; i < size; i += sizeof(uint32_t)) {
+    uint32_t word = rd();
+    std::memcpy(out + i, &word, std::min(sizeof(word), size - i));
+  }
+#endif
+}
+
+#if defined(VSCUUID_HAVE_CPU_RNG)
+
+struct CpuRngSupport {
+  bool rdrand = false;
+  bool rdseed = false;
+};
+
+CpuRngSupport DetectCpuRng() {
+  CpuRngSupport support;
+  unsigned eax, ebx, ecx, edx;
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+    support.rdrand = (ecx & bit_RDRND) != 0;
+  }
+  if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+    support.rdseed = (ebx & bit_RDSEED) != 0;
+  }
+  return support;
+}
+
+__attribute__((target("rdseed"))) bool ReadRdseed(uint64_t* value) {
+  unsigned long long word;
+  for (int attempt = 0; attempt < 16; ++attempt) {
+    if (_rdseed64_step(&word)) {
+      *value = word;
+      return true;
+    }
+    _mm_pause();
+  }
+  return false;
+}
+
+__attribute__((target("rdrnd"))) bool ReadRdrand(uint64_t* value) {
+  unsigned long long word;
+  for (int attempt = 0; attempt < 16; ++attempt) {
+    if (_rdrand64_step(&word)) {
+      *value = word;
+      return true;
+    }
+  }
+  return false;
+}
+
+#endif
+
+// XORs hardware random words into the key. This can only add entropy: the
+// kernel seed alone is already sufficient, so a faulty or absent CPU source
+// does not weaken the result.
+void MixCpuEntropy(uint32_t key[8]) {
+#if defined(VSCUUID_HAVE_CPU_RNG)
+  static const CpuRngSupport support = DetectCpuRng();
+  for (int i = 0; i < 4; ++i) {
+    uint64_t word = 0;
+    if ((support.rdseed && ReadRdseed(&word)) || (support.rdrand && ReadRdrand(&word))) {
+      key[2 * i] ^= static_cast<uint32_t>(word);
+      key[2 * i + 1] ^= static_cast<uint32_t>(word >> 32);
+    }
+  }
+#else
+  (void)key;
+#endif
+}
+
+void Reseed(ThreadState& state) {
+  uint8_t seed[kKeySize + sizeof(uint64_t)];
+  ReadOsEntropy(seed, sizeof(seed));
+  std::memcpy(state.key, seed, kKeySize);
+  std::memcpy(&state.nonce, seed + kKeySize, sizeof(state.nonce));
+  std::memset(seed, 0, sizeof(seed));
+  if (g_mix_cpu_entropy.load(std::memory_order_relaxed)) {
+    MixCpuEntropy(state.key);
+  }
+  state.counter = 0;
+  state.position = kBufferSize;
+  state.since_reseed = 0;
+  state.seeded = true;
+}
+
+// Generates a fresh buffer of keystream. The first 32 bytes replace the key
+// and are wiped ("fast key erasure"), so a later memory disclosure cannot
+// reconstruct output that was already handed out.
+void Refill(ThreadState& state) {
+  kernels::Active().chacha20(state.key, state.nonce, state.counter, state.buffer, kRefillBlocks);
+  state.counter += kRefillBlocks;
+  std::memcpy(state.key, state.buffer, kKeySize);
+  std::memset(state.buffer, 0, kKeySize);
+  state.position = kKeySize;
+}
+
+// A slot's key is replaced while other threads may be reading it: a thread
+// can be migrated between reserving blocks and reading the key, and the
+// atomic fallback shares slots between CPUs. The sequence number makes the
+// replacement a seqlock; it is odd while a writer is active.
+struct alignas(64) PerCpuKey {
+  std::atomic<uint32_t> sequence{0};
+  uint32_t key[8];
+  uint64_t nonce;
+  // Block counter of the slot when its key was last replaced.
+  std::atomic<uint64_t> keyed_at{0};
+};
+
+// Keys are written only with the mutex held. The whole table is rekeyed
+// whenever seeded_generation is stale, which first happens on first use and
+// then again right after fork(). fork() itself holds the mutex across the
+// call, so the child never inherits it locked or a key half written.
+struct PerCpuState {
+  PerCpuCounters counters;
+  std::unique_ptr<PerCpuKey[]> keys{new PerCpuKey[counters.slot_count()]};
+  std::mutex mutex;
+  std::atomic<uint64_t> seeded_generation{~uint64_t{0}};
+};
+
+PerCpuState* g_per_cpu_state = nullptr;
+
+void LockPerCpuForFork() {
+  g_per_cpu_state->mutex.lock();
+}
+
+void UnlockPerCpuAfterFork() {
+  g_per_cpu_state->mutex.unlock();
+}
+
+// Only the forking thread survives, so the mutex is rebuilt rather than
+// unlocked, and any sequence left odd is made even again.
+void ResetPerCpuInChild() {
+  PerCpuState& state = *g_per_cpu_state;
+  new (&state.mutex) std::mutex();
+  for (std::size_t slot = 0; slot < state.counters.slot_count(); ++slot) {
+    std::atomic<uint32_t>& sequence = state.keys[slot].sequence;
+    sequence.store((sequence.load(std::memory_order_relaxed) + 1) & ~uint32_t{1}, std::memory_order_relaxed);
+  }
+}
+
+PerCpuState& GetPerCpuState() {
+  // Never destroyed, so threads still drawing during exit stay safe.
+  static PerCpuState* state = [] {
+    g_per_cpu_state = new PerCpuState();
+#if defined(VSCUUID_HAVE_ATFORK)
+    pthread_atfork(LockPerCpuForFork, UnlockPerCpuAfterFork, ResetPerCpuInChild);
+#endif
+    return g_per_cpu_state;
+  }();
+  return *state;
+}
+
+// Replaces a slot's key with a fresh one from the kernel, overwriting the
+// old key. Requires the state mutex.
+void WritePerCpuKey(PerCpuKey& slot) {
+  uint8_t seed[kKeySize + sizeof(uint64_t)];
+  ReadOsEntropy(seed, sizeof(seed));
+  uint32_t key[8];
+  uint64_t nonce;
+  std::memcpy(key, seed, kKeySize);
+  std::memcpy(&nonce, seed + kKeySize, sizeof(nonce));
+  std::memset(seed, 0, sizeof(seed));
+  if (g_mix_cpu_entropy.load(std::memory_order_relaxed)) {
+    MixCpuEntropy(key);
+  }
+  const uint32_t sequence = slot.sequence.load(std::memory_order_relaxed) + 1;
+  slot.sequence.store(sequence, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (int i = 0; i < 8; ++i) {
+    std::atomic_ref<uint32_t>(slot.key[i]).store(key[i], std::memory_order_relaxed);
+  }
+  std::atomic_ref<uint64_t>(slot.nonce).store(nonce, std::memory_order_relaxed);
+  slot.sequence.store(sequence + 1, std::memory_order_release);
+  std::memset(key, 0, sizeof(key));
+}
+
+void ReadPerCpuKey(PerCpuKey& slot, uint32_t key[8], uint64_t* nonce) {
+  for (;;) {
+    const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+    if ((before & 1) != 0) {
+      continue;
+    }
+    for (int i = 0; i < 8; ++i) {
+      key[i] = std::atomic_ref<uint32_t>(slot.key[i]).load(std::memory_order_relaxed);
+    }
+    *nonce = std::atomic_ref<uint64_t>(slot.nonce).load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) == before) {
+      return;
+    }
+  }
+}
+
+void SeedPerCpu(PerCpuState& state, uint64_t generation) {
+  if (state.seeded_generation.load(std::memory_order_acquire) == generation) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(state.mutex);
+  if (state.seeded_generation.load(std::memory_order_relaxed) == generation) {
+    return;
+  }
+  for (std::size_t slot = 0; slot < state.counters.slot_count(); ++slot) {
+    WritePerCpuKey(state.keys[slot]);
+  }
+  state.seeded_generation.store(generation, std::memory_order_release);
+}
+
+// Rekeys a slot once reseed_interval bytes have been reserved on it since its
+// last key. Only the first thread past the threshold does the work.
+void MaybeRekeyPerCpu(PerCpuState& state, PerCpuKey& slot, uint64_t end, std::size_t interval) {
+  if (interval == 0) {
+    return;
+  }
+  const uint64_t interval_blocks = (interval + kChaChaBlockSize - 1) / kChaChaBlockSize;
+  auto due = [&] {
+    const uint64_t keyed_at = slot.keyed_at.load(std::memory_order_relaxed);
+    return end > keyed_at && end - keyed_at >= interval_blocks;
+  };
+  if (!due()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(state.mutex);
+  if (due()) {
+    WritePerCpuKey(slot);
+    slot.keyed_at.store(end, std::memory_order_relaxed);
+  }
+}
+
+// Reserves blocks on the calling CPU's counter and generates them on the
+// stack; nothing is buffered between calls. Counters keep running across
+// rekeys, so no key and counter pair is ever used twice.
+void FillPerCpu(std::span<uint8_t> out, uint64_t generation) {
+  PerCpuState& state = GetPerCpuState();
+  SeedPerCpu(state, generation);
+  const std::size_t interval = g_reseed_interval.load(std::memory_order_relaxed);
+  alignas(64) uint8_t blocks[kBufferSize];
+  uint32_t key[8];
+  uint64_t nonce;
+  while (!out.empty()) {
+    std::size_t count = std::min(kRefillBlocks, (out.size() + kChaChaBlockSize - 1) / kChaChaBlockSize);
+    std::size_t slot;
+    uint64_t counter = state.counters.FetchAdd(count, &slot);
+    MaybeRekeyPerCpu(state, state.keys[slot], counter + count, interval);
+    ReadPerCpuKey(state.keys[slot], key, &nonce);
+    kernels::Active().chacha20(key, nonce, counter, blocks, count);
+    std::size_t bytes = std::min(out.size(), count * kChaChaBlockSize);
+    std::memcpy(out.data(), blocks, bytes);
+    std::memset(blocks, 0, count * kChaChaBlockSize);
+    out = out.subspan(bytes);
+  }
+  std::memset(key, 0, sizeof(key));
+}
+
+}
+
+/**
+ * @brief Sets the process-wide entropy policy.
+ *
+ * The new reseed interval applies to every thread from its next refill on.
+ *
+ * @param options The policy to apply.
+ */
+void EntropySource::Configure(const EntropyOptions& options) {
+  g_reseed_interval.store(options.reseed_interval_bytes, std::memory_order_relaxed);
+  g_mix_cpu_entropy.store(options.mix_cpu_entropy, std::memory_order_relaxed);
+  g_backend.store(options.backend, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns the current process-wide entropy policy.
+ */
+EntropyOptions EntropySource::options() {
+  EntropyOptions options;
+  options.reseed_interval_bytes = g_reseed_interval.load(std::memory_order_relaxed);
+  options.mix_cpu_entropy = g_mix_cpu_entropy.load(std::memory_order_relaxed);
+  options.backend = g_backend.load(std::memory_order_relaxed);
+  return options;
+}
+
+/**
+ * @brief Fills a buffer with cryptographically strong random bytes.
+ *
+ * Each thread keeps a ChaCha20 keystream buffer that is refilled in bulk and
+ * keyed from the kernel (getrandom() where available), optionally mixed with
+ * RDSEED/RDRAND. The key is refreshed from the kernel every
+ * reseed_interval_bytes, and immediately after a fork() is detected, so parent
+ * and child never hand out the same bytes even if the fork happened with a
+ * partially consumed buffer. With StateBackend::kPerCpu the keystream comes
+ * from per-CPU keys instead, without a per-thread buffer; each CPU's key is
+ * replaced from the kernel after reseed_interval_bytes drawn on that CPU and
+ * after fork(), but not erased between those reseeds.
+ *
+ * @param out The destination buffer.
+ * @throws std::runtime_error if the kernel entropy source fails.
+ */
+void EntropySource::Fill(std::span<uint8_t> out) {
+  InstallForkDetection();
+  const uint64_t generation = CurrentForkGeneration();
+  if (g_backend.load(std::memory_order_relaxed) == StateBackend::kPerCpu) {
+    FillPerCpu(out, generation);
+    return;
+  }
+  ThreadState& state = t_state;
+  if (!state.seeded || state.fork_generation != generation) {
+    Reseed(state);
+    state.fork_generation = generation;
+  }
+  const std::size_t interval = g_reseed_interval.load(std::memory_order_relaxed);
+  while (!out.empty()) {
+    if (state.position == kBufferSize) {
+      if (interval != 0 && state.since_reseed >= interval) {
+        Reseed(state);
+      }
+      Refill(state);
+    }
+    std::size_t count = std::min(out.size(), kBufferSize - state.position);
+    std::memcpy(out.data(), state.buffer + state.position, count);
+    std::memset(state.buffer + state.position, 0, count);
+    state.position += count;
+    state.since_reseed += count;
+    out = out.subspan(count);
+  }
+}
+
+/**
+ * @brief Returns 64 random bits from the calling thread's entropy buffer.
+ */
+uint64_t EntropySource::Next64() {
+  uint64_t value;
+  Fill(std::span<uint8_t>(reinterpret_cast<uint8_t*>(&value), sizeof(value)));
+  return value;
+}
+
+}
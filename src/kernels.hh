@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "vscuuid/uuid.hh"
+#include "vscuuid/uuid_scanner.hh"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define VSCUUID_X86_KERNELS 1
+#endif
+
+namespace vscuuid {
+namespace kernels {
+
+static_assert(sizeof(Uuid) == 16, "kernels treat Uuid arrays as packed 16 byte records");
+
+// Every kernel family has the same signature across ISA tiers so that the
+// dispatch table can bind whichever variant the CPU supports.
+using FormatKernel = void (*)(const Uuid* uuids, std::size_t count, char* out);
+using ParseKernel = std::size_t (*)(const char* text, std::size_t count, Uuid* out);
+using ScanKernel = void (*)(const char* data, std::size_t size, std::size_t begin,
+                            std::size_t end, std::vector<UuidMatch>* out);
+using ChaChaKernel = void (*)(const uint32_t key[8], uint64_t nonce, uint64_t counter,
+                              uint8_t* out, std::size_t blocks);
+// in and out may be the same array.
+using ConvertKernel = void (*)(const Uuid* in, std::size_t count, Uuid* out);
+
+// Bit i set for every hex position of an 8-4-4-4-12 UUID starting at bit 0.
+inline constexpr uint64_t kUuidHexPattern =
+    ((uint64_t{1} << 36) - 1) & ~((uint64_t{1} << 8) | (uint64_t{1} << 13) |
+                                  (uint64_t{1} << 18) | (uint64_t{1} << 23));
+
+inline bool IsHexDigit(char c) {
+  unsigned char u = static_cast<unsigned char>(c);
+  return static_cast<unsigned>(u - '0') < 10u || static_cast<unsigned>((u | 0x20) - 'a') < 6u;
+}
+
+inline void EmitMatch(const char* data, std::size_t start, std::vector<UuidMatch>* out) {
+  UuidMatch match{start, Uuid()};
+  Uuid::TryParse(std::string_view(data + start, kUuidStringLength), &match.uuid);
+  out->push_back(match);
+}
+
+void FormatScalar(const Uuid* uuids, std::size_t count, char* out);
+std::size_t ParseScalar(const char* text, std::size_t count, Uuid* out);
+void ScanScalar(const char* data, std::size_t size, std::size_t begin, std::size_t end,
+                std::vector<UuidMatch>* out);
+void ChaCha20Scalar(const uint32_t key[8], uint64_t nonce, uint64_t counter, uint8_t* out,
+                    std::size_t blocks);
+void ConvertV1ToV6Scalar(const Uuid* in, std::size_t count, Uuid* out);
+void ConvertV6ToV1Scalar(const Uuid* in, std::size_t count, Uuid* out);
+
+#if defined(VSCUUID_X86_KERNELS)
+void FormatAvx2(const Uuid* uuids, std::size_t count, char* out);
+std::size_t ParseAvx2(const char* text, std::size_t count, Uuid* out);
+void ScanAvx2(const char* data, std::size_t size, std::size_t begin, std::size_t end,
+              std::vector<UuidMatch>* out);
+void ChaCha20Avx2(const uint32_t key[8], uint64_t nonce, uint64_t counter, uint8_t* out,
+                  std::size_t blocks);
+void ConvertV1ToV6Avx2(const Uuid* in, std::size_t count, Uuid* out);
+void ConvertV6ToV1Avx2(const Uuid* in, std::size_t count, Uuid* out);
+
+void FormatAvx512(const Uuid* uuids, std::size_t count, char* out);
+std::size_t ParseAvx512(const char* text, std::size_t count, Uuid* out);
+void ScanAvx512(const char* data, std::size_t size, std::size_t begin, std::size_t end,
+                std::vector<UuidMatch>* out);
+void ChaCha20Avx512(const uint32_t key[8], uint64_t nonce, uint64_t counter, uint8_t* out,
+                    std::size_t blocks);
+void ConvertV1ToV6Avx512(const Uuid* in, std::size_t count, Uuid* out);
+void ConvertV6ToV1Avx512(const Uuid* in, std::size_t count, Uuid* out);
+#endif
+
+}
+}
@@ -0,0 +1,269 @@
+#include "kernels.hh"
+
+#if defined(VSCUUID_X86_KERNELS)
+
+#if defined(__GNUC__) && !defined(__clang__)
+// The vector templates from chacha20.hh and time_layout.hh are always inlined
+// into the kernels below, so the vector calling convention GCC warns about is
+// never used.
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+#include "chacha20.hh"
+#include "time_layout.hh"
+
+#include <cstring>
+#include <immintrin.h>
+
+#define VSCUUID_TARGET_AVX2 __attribute__((target("avx2")))
+
+namespace vscuuid {
+namespace kernels {
+
+namespace {
+
+VSCUUID_TARGET_AVX2 inline uint32_t HyphenMask32(__m256i chunk) {
+  return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('-'))));
+}
+
+VSCUUID_TARGET_AVX2 inline __m256i HexBytes(__m256i chunk) {
+  __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(chunk, _mm256_set1_epi8('0' - 1)),
+                                   _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chunk));
+  __m256i folded = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+  __m256i alpha = _mm256_and_si256(_mm256_cmpgt_epi8(folded, _mm256_set1_epi8('a' - 1)),
+                                   _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), folded));
+  return _mm256_or_si256(digit, alpha);
+}
+
+VSCUUID_TARGET_AVX2 inline uint32_t HexMask32(__m256i chunk) {
+  return static_cast<uint32_t>(_mm256_movemask_epi8(HexBytes(chunk)));
+}
+
+// Converts two UUIDs per step. The in-lane byte shuffle reverses the first
+// eight bytes of each UUID, turning its high half into a native integer, and
+// is its own inverse; the blend keeps the low halves unchanged.
+template <bool kToV6>
+VSCUUID_TARGET_AVX2 inline std::size_t ConvertTimeLayoutAvx2(const Uuid* in, std::size_t count, Uuid* out) {
+  typedef uint64_t Words __attribute__((vector_size(32)));
+  const __m256i reverse_high = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 8, 9, 10, 11, 12, 13, 14, 15,
+                                                7, 6, 5, 4, 3, 2, 1, 0, 8, 9, 10, 11, 12, 13, 14, 15);
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    __m256i native = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)),
+                                         reverse_high);
+    Words words = reinterpret_cast<Words>(native);
+    Words converted;
+    if constexpr (kToV6) {
+      converted = TimestampToV6High(V1HighToTimestamp(words));
+    } else {
+      converted = TimestampToV1High(V6HighToTimestamp(words));
+    }
+    native = _mm256_blend_epi32(native, reinterpret_cast<__m256i>(converted), 0x33);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_shuffle_epi8(native, reverse_high));
+  }
+  return i;
+}
+
+// Maps validated hex digits to their values: the low nibble of '0'-'9' is the
+// value already, letters of either case need 9 added.
+VSCUUID_TARGET_AVX2 inline __m256i Nibbles(__m256i chars) {
+  __m256i letter = _mm256_cmpgt_epi8(chars, _mm256_set1_epi8('9'));
+  return _mm256_add_epi8(_mm256_and_si256(chars, _mm256_set1_epi8(0x0F)),
+                         _mm256_and_si256(letter, _mm256_set1_epi8(9)));
+}
+
+VSCUUID_TARGET_AVX2 inline __m256i LoadLanes(const char* lane0, const char* lane1) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lane0))),
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(lane1)), 1);
+}
+
+VSCUUID_TARGET_AVX2 inline __m256i LoadTails(const char* lane0, const char* lane1) {
+  int32_t tail0;
+  int32_t tail1;
+  std::memcpy(&tail0, lane0, sizeof(tail0));
+  std::memcpy(&tail1, lane1, sizeof(tail1));
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_cvtsi32_si128(tail0)),
+                                 _mm_cvtsi32_si128(tail1), 1);
+}
+
+VSCUUID_TARGET_AVX2 inline void StoreRecord(char* out, __m128i first, __m128i second, __m128i hex_tail) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out), first);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), second);
+  int32_t tail = _mm_extract_epi32(hex_tail, 3);
+  std::memcpy(out + 32, &tail, sizeof(tail));
+}
+
+}
+
+/**
+ * @brief AVX2 formatting kernel, two UUIDs per iteration.
+ *
+ * Each 128-bit lane holds one UUID. Its bytes are split into nibbles and
+ * interleaved into 32 digit indices, translated to ASCII with one in-lane
+ * table shuffle, and then spread into the 8-4-4-4-12 positions with two more
+ * shuffles whose holes are filled with hyphens.
+ */
+VSCUUID_TARGET_AVX2 void FormatAvx2(const Uuid* uuids, std::size_t count, char* out) {
+  const __m256i table = _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+                                         '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+  const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+  // out[0..15] = hex[0..7] - hex[8..11] - hex[12..13]
+  const __m256i spread0 = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, -1, 8, 9, 10, 11, -1, 12, 13,
+                                           0, 1, 2, 3, 4, 5, 6, 7, -1, 8, 9, 10, 11, -1, 12, 13);
+  const __m256i dashes0 = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, '-', 0, 0, 0, 0, '-', 0, 0,
+                                           0, 0, 0, 0, 0, 0, 0, 0, '-', 0, 0, 0, 0, '-', 0, 0);
+  // out[16..31] = hex[14..15] - hex[16..19] - hex[20..27], indexed from hex[14]
+  const __m256i spread1 = _mm256_setr_epi8(0, 1, -1, 2, 3, 4, 5, -1, 6, 7, 8, 9, 10, 11, 12, 13,
+                                           0, 1, -1, 2, 3, 4, 5, -1, 6, 7, 8, 9, 10, 11, 12, 13);
+  const __m256i dashes1 = _mm256_setr_epi8(0, 0, '-', 0, 0, 0, 0, '-', 0, 0, 0, 0, 0, 0, 0, 0,
+                                           0, 0, '-', 0, 0, 0, 0, '-', 0, 0, 0, 0, 0, 0, 0, 0);
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(uuids + i));
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(bytes, 4), low_nibble);
+    __m256i lo = _mm256_and_si256(bytes, low_nibble);
+    __m256i hex_a = _mm256_shuffle_epi8(table, _mm256_unpacklo_epi8(hi, lo));
+    __m256i hex_b = _mm256_shuffle_epi8(table, _mm256_unpackhi_epi8(hi, lo));
+    __m256i first = _mm256_or_si256(_mm256_shuffle_epi8(hex_a, spread0), dashes0);
+    __m256i middle = _mm256_alignr_epi8(hex_b, hex_a, 14);
+    __m256i second = _mm256_or_si256(_mm256_shuffle_epi8(middle, spread1), dashes1);
+
+    char* record = out + i * kUuidStringLength;
+    StoreRecord(record, _mm256_castsi256_si128(first), _mm256_castsi256_si128(second),
+                _mm256_castsi256_si128(hex_b));
+    StoreRecord(record + kUuidStringLength, _mm256_extracti128_si256(first, 1),
+                _mm256_extracti128_si256(second, 1), _mm256_extracti128_si256(hex_b, 1));
+  }
+  FormatScalar(uuids + i, count - i, out + i * kUuidStringLength);
+}
+
+/**
+ * @brief AVX2 parsing kernel, two UUIDs per iteration.
+ *
+ * The inverse of FormatAvx2: shuffles gather the 32 digits of each record
+ * into two registers, range compares validate digits and hyphens, and
+ * digits are converted to nibbles and paired with a multiply-add.
+ *
+ * @return The number of leading records that were valid.
+ */
+VSCUUID_TARGET_AVX2 std::size_t ParseAvx2(const char* text, std::size_t count, Uuid* out) {
+  // hex[0..15] from text[0..15] and text[16..17]
+  const __m256i gather_a0 = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 14, 15, -1, -1,
+                                             0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 14, 15, -1, -1);
+  const __m256i gather_b0 = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 1,
+                                             -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 1);
+  // hex[16..31] from text[19..22], text[24..31] and text[32..35]
+  const __m256i gather_b1 = _mm256_setr_epi8(3, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1,
+                                             3, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1);
+  const __m256i gather_c1 = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 1, 2, 3,
+                                             -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 1, 2, 3);
+  const __m256i pair_weights = _mm256_set1_epi16(0x0110);
+
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    const char* record0 = text + i * kUuidStringLength;
+    const char* record1 = record0 + kUuidStringLength;
+    __m256i a = LoadLanes(record0, record1);
+    __m256i b = LoadLanes(record0 + 16, record1 + 16);
+    __m256i c = LoadTails(record0 + 32, record1 + 32);
+
+    __m256i hex0 = _mm256_or_si256(_mm256_shuffle_epi8(a, gather_a0), _mm256_shuffle_epi8(b, gather_b0));
+    __m256i hex1 = _mm256_or_si256(_mm256_shuffle_epi8(b, gather_b1), _mm256_shuffle_epi8(c, gather_c1));
+
+    uint32_t dash_a = HyphenMask32(a);
+    uint32_t dash_b = HyphenMask32(b);
+    uint32_t digits = HexMask32(hex0) & HexMask32(hex1);
+    bool valid0 = (dash_a & 0x2100) == 0x2100 && (dash_b & 0x84) == 0x84 && (digits & 0xFFFF) == 0xFFFF;
+    bool valid1 = (dash_a & 0x21000000) == 0x21000000 && (dash_b & 0x840000) == 0x840000 &&
+                  (digits >> 16) == 0xFFFF;
+
+    __m256i bytes = _mm256_packus_epi16(_mm256_maddubs_epi16(Nibbles(hex0), pair_weights),
+                                        _mm256_maddubs_epi16(Nibbles(hex1), pair_weights));
+    if (!valid0) {
+      return i;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_castsi256_si128(bytes));
+    if (!valid1) {
+      return i + 1;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 1), _mm256_extracti128_si256(bytes, 1));
+  }
+  return i + ParseScalar(text + i * kUuidStringLength, count - i, out + i);
+}
+
+/**
+ * @brief AVX2 scanning kernel.
+ *
+ * Each step classifies a 64 byte window into hyphen and hex-digit bit masks.
+ * A UUID can only start at offset j when bits j+8, j+13, j+18 and j+23 of the
+ * hyphen mask are set, and it is valid when the remaining 32 positions are set
+ * in the hex mask and its neighbours are not. Both tests are a handful of shifts
+ * on the masks, so the text is only touched again to parse confirmed matches.
+ * Starts 0..27 of every window are resolved, keeping j + 36 inside the window.
+ */
+VSCUUID_TARGET_AVX2 void ScanAvx2(const char* data, std::size_t size, std::size_t begin,
+                                  std::size_t end, std::vector<UuidMatch>* out) {
+  constexpr std::size_t kStride = 28;
+  std::size_t i = begin;
+  while (i < end && i + 64 <= size) {
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32));
+    uint64_t hyphen = HyphenMask32(lo) | (uint64_t{HyphenMask32(hi)} << 32);
+    uint64_t hex = HexMask32(lo) | (uint64_t{HexMask32(hi)} << 32);
+
+    uint64_t candidates = (hyphen >> 8) & (hyphen >> 13) & (hyphen >> 18) & (hyphen >> 23) &
+                          ((uint64_t{1} << kStride) - 1);
+    if (end - i < kStride) {
+      candidates &= (uint64_t{1} << (end - i)) - 1;
+    }
+    while (candidates != 0) {
+      unsigned j = static_cast<unsigned>(__builtin_ctzll(candidates));
+      candidates &= candidates - 1;
+      if (((hex >> j) & kUuidHexPattern) != kUuidHexPattern || ((hex >> (j + 36)) & 1) != 0) {
+        continue;
+      }
+      bool hex_before = j > 0 ? ((hex >> (j - 1)) & 1) != 0 : (i > 0 && IsHexDigit(data[i - 1]));
+      if (!hex_before) {
+        EmitMatch(data, i + j, out);
+      }
+    }
+    i += kStride;
+  }
+  ScanScalar(data, size, i, end, out);
+}
+
+/**
+ * @brief AVX2 ChaCha20 kernel generating eight blocks per iteration.
+ */
+VSCUUID_TARGET_AVX2 void ChaCha20Avx2(const uint32_t key[8], uint64_t nonce, uint64_t counter,
+                                      uint8_t* out, std::size_t blocks) {
+  typedef uint32_t Vector __attribute__((vector_size(32)));
+  constexpr std::size_t kLanes = 8;
+  std::size_t done = 0;
+  for (; done + kLanes <= blocks; done += kLanes) {
+    ChaCha20VectorBlocks<Vector, kLanes>(key, nonce, counter + done, out + done * kChaChaBlockSize);
+  }
+  ChaCha20Blocks(key, nonce, counter + done, out + done * kChaChaBlockSize, blocks - done);
+}
+
+/**
+ * @brief AVX2 conversion of version 1 UUIDs to the version 6 layout, 2 per step.
+ */
+VSCUUID_TARGET_AVX2 void ConvertV1ToV6Avx2(const Uuid* in, std::size_t count, Uuid* out) {
+  std::size_t done = ConvertTimeLayoutAvx2<true>(in, count, out);
+  ConvertTimeLayoutScalar<true>(in + done, count - done, out + done);
+}
+
+/**
+ * @brief AVX2 conversion of version 6 UUIDs to the version 1 layout, 2 per step.
+ */
+VSCUUID_TARGET_AVX2 void ConvertV6ToV1Avx2(const Uuid* in, std::size_t count, Uuid* out) {
+  std::size_t done = ConvertTimeLayoutAvx2<false>(in, count, out);
+  ConvertTimeLayoutScalar<false>(in + done, count - done, out + done);
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,250 @@
+#include "kernels.hh"
+
+#if defined(VSCUUID_X86_KERNELS)
+
+#if defined(__GNUC__) && !defined(__clang__)
+// The vector templates from chacha20.hh and time_layout.hh are always inlined
+// into the kernels below, so the vector calling convention GCC warns about is
+// never used.
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+#include "chacha20.hh"
+#include "time_layout.hh"
+
+#include <cstring>
+#include <immintrin.h>
+
+#define VSCUUID_TARGET_AVX512 __attribute__((target("avx2,avx512f,avx512bw")))
+
+namespace vscuuid {
+namespace kernels {
+
+namespace {
+
+VSCUUID_TARGET_AVX512 inline __mmask64 HexMask64(__m512i chunk) {
+  __mmask64 digit = _mm512_cmp_epu8_mask(_mm512_sub_epi8(chunk, _mm512_set1_epi8('0')),
+                                          _mm512_set1_epi8(10), _MM_CMPINT_LT);
+  __m512i folded = _mm512_or_si512(chunk, _mm512_set1_epi8(0x20));
+  __mmask64 alpha = _mm512_cmp_epu8_mask(_mm512_sub_epi8(folded, _mm512_set1_epi8('a')),
+                                          _mm512_set1_epi8(6), _MM_CMPINT_LT);
+  return digit | alpha;
+}
+
+VSCUUID_TARGET_AVX512 inline __mmask64 HyphenMask64(__m512i chunk) {
+  return _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('-'));
+}
+
+// Broadcasts a 16 byte shuffle pattern to all four lanes. The masked form
+// avoids GCC 12 warning about the undefined source of the unmasked one.
+VSCUUID_TARGET_AVX512 inline __m512i Lanes(__m128i pattern) {
+  return _mm512_mask_broadcast_i32x4(_mm512_setzero_si512(), 0xFFFF, pattern);
+}
+
+// Converts four UUIDs per step. The in-lane byte shuffle reverses the first
+// eight bytes of each UUID, turning its high half into a native integer, and
+// is its own inverse; the blend keeps the low halves unchanged.
+template <bool kToV6>
+VSCUUID_TARGET_AVX512 inline std::size_t ConvertTimeLayoutAvx512(const Uuid* in, std::size_t count, Uuid* out) {
+  typedef uint64_t Words __attribute__((vector_size(64)));
+  const __m512i reverse_high = Lanes(_mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 8, 9, 10, 11, 12, 13, 14, 15));
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m512i native = _mm512_shuffle_epi8(_mm512_loadu_si512(in + i), reverse_high);
+    Words words = reinterpret_cast<Words>(native);
+    Words converted;
+    if constexpr (kToV6) {
+      converted = TimestampToV6High(V1HighToTimestamp(words));
+    } else {
+      converted = TimestampToV1High(V6HighToTimestamp(words));
+    }
+    native = _mm512_mask_blend_epi64(0x55, native, reinterpret_cast<__m512i>(converted));
+    _mm512_storeu_si512(out + i, _mm512_shuffle_epi8(native, reverse_high));
+  }
+  return i;
+}
+
+VSCUUID_TARGET_AVX512 inline __m512i LoadLanes(const char* record, std::size_t offset) {
+  __m512i v = _mm512_castsi128_si512(_mm_loadu_si128(reinterpret_cast<const __m128i*>(record + offset)));
+  v = _mm512_inserti32x4(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(record + kUuidStringLength + offset)), 1);
+  v = _mm512_inserti32x4(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(record + 2 * kUuidStringLength + offset)), 2);
+  return _mm512_inserti32x4(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(record + 3 * kUuidStringLength + offset)), 3);
+}
+
+VSCUUID_TARGET_AVX512 inline __m512i LoadTails(const char* record) {
+  int32_t tails[4];
+  for (int lane = 0; lane < 4; ++lane) {
+    std::memcpy(&tails[lane], record + lane * kUuidStringLength + 32, sizeof(int32_t));
+  }
+  __m512i v = _mm512_castsi128_si512(_mm_cvtsi32_si128(tails[0]));
+  v = _mm512_inserti32x4(v, _mm_cvtsi32_si128(tails[1]), 1);
+  v = _mm512_inserti32x4(v, _mm_cvtsi32_si128(tails[2]), 2);
+  return _mm512_inserti32x4(v, _mm_cvtsi32_si128(tails[3]), 3);
+}
+
+}
+
+/**
+ * @brief AVX-512 formatting kernel, four UUIDs per iteration.
+ *
+ * Same lane-local algorithm as FormatAvx2, on 512-bit registers.
+ */
+VSCUUID_TARGET_AVX512 void FormatAvx512(const Uuid* uuids, std::size_t count, char* out) {
+  const __m512i table = Lanes(_mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'));
+  const __m512i low_nibble = _mm512_set1_epi8(0x0F);
+  const __m512i spread0 = Lanes(_mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, -1, 8, 9, 10, 11, -1, 12, 13));
+  const __m512i dashes0 = Lanes(_mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, '-', 0, 0, 0, 0, '-', 0, 0));
+  const __m512i spread1 = Lanes(_mm_setr_epi8(0, 1, -1, 2, 3, 4, 5, -1, 6, 7, 8, 9, 10, 11, 12, 13));
+  const __m512i dashes1 = Lanes(_mm_setr_epi8(0, 0, '-', 0, 0, 0, 0, '-', 0, 0, 0, 0, 0, 0, 0, 0));
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m512i bytes = _mm512_loadu_si512(uuids + i);
+    __m512i hi = _mm512_and_si512(_mm512_srli_epi16(bytes, 4), low_nibble);
+    __m512i lo = _mm512_and_si512(bytes, low_nibble);
+    __m512i hex_a = _mm512_shuffle_epi8(table, _mm512_unpacklo_epi8(hi, lo));
+    __m512i hex_b = _mm512_shuffle_epi8(table, _mm512_unpackhi_epi8(hi, lo));
+    __m512i first = _mm512_or_si512(_mm512_shuffle_epi8(hex_a, spread0), dashes0);
+    __m512i middle = _mm512_alignr_epi8(hex_b, hex_a, 14);
+    __m512i second = _mm512_or_si512(_mm512_shuffle_epi8(middle, spread1), dashes1);
+
+    alignas(64) char first_lanes[64];
+    alignas(64) char second_lanes[64];
+    alignas(64) char tail_lanes[64];
+    _mm512_store_si512(first_lanes, first);
+    _mm512_store_si512(second_lanes, second);
+    _mm512_store_si512(tail_lanes, hex_b);
+    char* record = out + i * kUuidStringLength;
+    for (int lane = 0; lane < 4; ++lane, record += kUuidStringLength) {
+      std::memcpy(record, first_lanes + 16 * lane, 16);
+      std::memcpy(record + 16, second_lanes + 16 * lane, 16);
+      std::memcpy(record + 32, tail_lanes + 16 * lane + 12, 4);
+    }
+  }
+  FormatAvx2(uuids + i, count - i, out + i * kUuidStringLength);
+}
+
+/**
+ * @brief AVX-512 parsing kernel, four UUIDs per iteration.
+ *
+ * Same lane-local algorithm as ParseAvx2; validation uses mask registers.
+ *
+ * @return The number of leading records that were valid.
+ */
+VSCUUID_TARGET_AVX512 std::size_t ParseAvx512(const char* text, std::size_t count, Uuid* out) {
+  const __m512i gather_a0 = Lanes(_mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 14, 15, -1, -1));
+  const __m512i gather_b0 = Lanes(_mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 1));
+  const __m512i gather_b1 = Lanes(_mm_setr_epi8(3, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1));
+  const __m512i gather_c1 = Lanes(_mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 1, 2, 3));
+  const __m512i pair_weights = _mm512_set1_epi16(0x0110);
+  const __m512i low_nibble = _mm512_set1_epi8(0x0F);
+  const __m512i letter_offset = _mm512_set1_epi8(9);
+  const __m512i nine = _mm512_set1_epi8('9');
+  // Hyphens at offsets 8 and 13 of every A lane and 2 and 7 of every B lane.
+  constexpr uint64_t kDashA = 0x2100210021002100ULL;
+  constexpr uint64_t kDashB = 0x0084008400840084ULL;
+
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const char* record = text + i * kUuidStringLength;
+    __m512i a = LoadLanes(record, 0);
+    __m512i b = LoadLanes(record, 16);
+    __m512i c = LoadTails(record);
+
+    __m512i hex0 = _mm512_or_si512(_mm512_shuffle_epi8(a, gather_a0), _mm512_shuffle_epi8(b, gather_b0));
+    __m512i hex1 = _mm512_or_si512(_mm512_shuffle_epi8(b, gather_b1), _mm512_shuffle_epi8(c, gather_c1));
+
+    uint64_t dash_missing = (~HyphenMask64(a) & kDashA) | (~HyphenMask64(b) & kDashB);
+    uint64_t bad = dash_missing | ~(HexMask64(hex0) & HexMask64(hex1));
+
+    __m512i nib0 = _mm512_add_epi8(_mm512_and_si512(hex0, low_nibble),
+                                   _mm512_maskz_mov_epi8(_mm512_cmpgt_epi8_mask(hex0, nine), letter_offset));
+    __m512i nib1 = _mm512_add_epi8(_mm512_and_si512(hex1, low_nibble),
+                                   _mm512_maskz_mov_epi8(_mm512_cmpgt_epi8_mask(hex1, nine), letter_offset));
+    __m512i bytes = _mm512_packus_epi16(_mm512_maddubs_epi16(nib0, pair_weights),
+                                        _mm512_maddubs_epi16(nib1, pair_weights));
+    if (bad == 0) {
+      _mm512_storeu_si512(out + i, bytes);
+      continue;
+    }
+    std::size_t valid = static_cast<std::size_t>(__builtin_ctzll(bad)) / 16;
+    alignas(64) Uuid lanes[4];
+    _mm512_store_si512(lanes, bytes);
+    for (std::size_t lane = 0; lane < valid; ++lane) {
+      out[i + lane] = lanes[lane];
+    }
+    return i + valid;
+  }
+  return i + ParseAvx2(text + i * kUuidStringLength, count - i, out + i);
+}
+
+/**
+ * @brief AVX-512 scanning kernel.
+ *
+ * The AVX2 algorithm with both 64 bit masks produced directly by mask
+ * compares over one register.
+ */
+VSCUUID_TARGET_AVX512 void ScanAvx512(const char* data, std::size_t size, std::size_t begin,
+                                      std::size_t end, std::vector<UuidMatch>* out) {
+  constexpr std::size_t kStride = 28;
+  std::size_t i = begin;
+  while (i < end && i + 64 <= size) {
+    __m512i chunk = _mm512_loadu_si512(data + i);
+    uint64_t hyphen = HyphenMask64(chunk);
+    uint64_t candidates = (hyphen >> 8) & (hyphen >> 13) & (hyphen >> 18) & (hyphen >> 23) &
+                          ((uint64_t{1} << kStride) - 1);
+    if (end - i < kStride) {
+      candidates &= (uint64_t{1} << (end - i)) - 1;
+    }
+    if (candidates != 0) {
+      uint64_t hex = HexMask64(chunk);
+      while (candidates != 0) {
+        unsigned j = static_cast<unsigned>(__builtin_ctzll(candidates));
+        candidates &= candidates - 1;
+        if (((hex >> j) & kUuidHexPattern) != kUuidHexPattern || ((hex >> (j + 36)) & 1) != 0) {
+          continue;
+        }
+        bool hex_before = j > 0 ? ((hex >> (j - 1)) & 1) != 0 : (i > 0 && IsHexDigit(data[i - 1]));
+        if (!hex_before) {
+          EmitMatch(data, i + j, out);
+        }
+      }
+    }
+    i += kStride;
+  }
+  ScanScalar(data, size, i, end, out);
+}
+
+/**
+ * @brief AVX-512 ChaCha20 kernel generating sixteen blocks per iteration.
+ */
+VSCUUID_TARGET_AVX512 void ChaCha20Avx512(const uint32_t key[8], uint64_t nonce, uint64_t counter,
+                                          uint8_t* out, std::size_t blocks) {
+  typedef uint32_t Vector __attribute__((vector_size(64)));
+  constexpr std::size_t kLanes = 16;
+  std::size_t done = 0;
+  for (; done + kLanes <= blocks; done += kLanes) {
+    ChaCha20VectorBlocks<Vector, kLanes>(key, nonce, counter + done, out + done * kChaChaBlockSize);
+  }
+  ChaCha20Avx2(key, nonce, counter + done, out + done * kChaChaBlockSize, blocks - done);
+}
+
+/**
+ * @brief AVX-512 conversion of version 1 UUIDs to the version 6 layout, 4 per step.
+ */
+VSCUUID_TARGET_AVX512 void ConvertV1ToV6Avx512(const Uuid* in, std::size_t count, Uuid* out) {
+  std::size_t done = ConvertTimeLayoutAvx512<true>(in, count, out);
+  ConvertTimeLayoutScalar<true>(in + done, count - done, out + done);
+}
+
+/**
+ * @brief AVX-512 conversion of version 6 UUIDs to the version 1 layout, 4 per step.
+ */
+VSCUUID_TARGET_AVX512 void ConvertV6ToV1Avx512(const Uuid* in, std::size_t count, Uuid* out) {
+  std::size_t done = ConvertTimeLayoutAvx512<false>(in, count, out);
+  ConvertTimeLayoutScalar<false>(in + done, count - done, out + done);
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,107 @@
+#include "kernels.hh"
+#include "chacha20.hh"
+#include "time_layout.hh"
+
+#include <algorithm>
+#include <cstring>
+
+namespace vscuuid {
+namespace kernels {
+
+namespace {
+
+bool ScanMatchesAt(const char* data, std::size_t size, std::size_t start) {
+  if (start + kUuidStringLength > size) {
+    return false;
+  }
+  const char* p = data + start;
+  for (std::size_t k = 0; k < kUuidStringLength; ++k) {
+    bool want_hex = (kUuidHexPattern >> k) & 1;
+    if (want_hex ? !IsHexDigit(p[k]) : p[k] != '-') {
+      return false;
+    }
+  }
+  if (start > 0 && IsHexDigit(p[-1])) {
+    return false;
+  }
+  return start + kUuidStringLength == size || !IsHexDigit(p[kUuidStringLength]);
+}
+
+}
+
+/**
+ * @brief Formats count UUIDs into consecutive 36 character records.
+ */
+void FormatScalar(const Uuid* uuids, std::size_t count, char* out) {
+  for (std::size_t i = 0; i < count; ++i) {
+    uuids[i].FormatTo(std::span<char, kUuidStringLength>(out + i * kUuidStringLength, kUuidStringLength));
+  }
+}
+
+/**
+ * @brief Parses consecutive 36 character records.
+ *
+ * @return The number of leading records that were valid; parsing stops at the first invalid one.
+ */
+std::size_t ParseScalar(const char* text, std::size_t count, Uuid* out) {
+  for (std::size_t i = 0; i < count; ++i) {
+    if (!Uuid::TryParse(std::string_view(text + i * kUuidStringLength, kUuidStringLength), out + i)) {
+      return i;
+    }
+  }
+  return count;
+}
+
+/**
+ * @brief Scalar scanning kernel.
+ *
+ * Every hyphen is tried as the first hyphen of a UUID, i.e. as offset 8 of a
+ * candidate; memchr does the skipping between hyphens.
+ */
+void ScanScalar(const char* data, std::size_t size, std::size_t begin, std::size_t end,
+                std::vector<UuidMatch>* out) {
+  if (size < kUuidStringLength) {
+    return;
+  }
+  std::size_t last_start = std::min(end, size - kUuidStringLength + 1);
+  std::size_t start = begin;
+  while (start < last_start) {
+    const void* hyphen = std::memchr(data + start + 8, '-', last_start - start);
+    if (hyphen == nullptr) {
+      break;
+    }
+    std::size_t candidate = static_cast<std::size_t>(static_cast<const char*>(hyphen) - data) - 8;
+    if (ScanMatchesAt(data, size, candidate)) {
+      EmitMatch(data, candidate, out);
+      start = candidate + kUuidStringLength;
+    } else {
+      start = candidate + 1;
+    }
+  }
+}
+
+/**
+ * @brief Generates ChaCha20 keystream one block at a time.
+ */
+void ChaCha20Scalar(const uint32_t key[8], uint64_t nonce, uint64_t counter, uint8_t* out,
+                    std::size_t blocks) {
+  ChaCha20Blocks(key, nonce, counter, out, blocks);
+}
+
+
+/**
+ * @brief Rewrites version 1 UUIDs in the version 6 layout.
+ */
+void ConvertV1ToV6Scalar(const Uuid* in, std::size_t count, Uuid* out) {
+  ConvertTimeLayoutScalar<true>(in, count, out);
+}
+
+/**
+ * @brief Rewrites version 6 UUIDs in the version 1 layout.
+ */
+void ConvertV6ToV1Scalar(const Uuid* in, std::size_t count, Uuid* out) {
+  ConvertTimeLayoutScalar<false>(in, count, out);
+}
+
+}
+}
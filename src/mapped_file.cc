@@ -0,0 +1,72 @@
+#include "mapped_file.hh"
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define VSCUUID_HAVE_MMAP 1
+#endif
+
+namespace vscuuid {
+
+/**
+ * @brief Maps a file read-only into memory.
+ *
+ * On POSIX systems the file is mmap'd and advised for sequential access, so
+ * multi-gigabyte inputs are paged in on demand. Elsewhere the file is read into
+ * an owned buffer.
+ *
+ * @param path The file to map.
+ * @throws std::runtime_error if the file cannot be opened or mapped.
+ */
+MappedFile::MappedFile(const std::string& path) {
+#if defined(VSCUUID_HAVE_MMAP)
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open file: " + path);
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Failed to stat file: " + path);
+  }
+  size_ = static_cast<std::size_t>(st.st_size);
+  if (size_ > 0) {
+    void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Failed to map file: " + path);
+    }
+    ::madvise(addr, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(addr);
+    mapped_ = true;
+  }
+  ::close(fd);
+#else
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("Failed to open file: " + path);
+  }
+  fallback_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  data_ = fallback_.data();
+  size_ = fallback_.size();
+#endif
+}
+
+/**
+ * @brief Unmaps the file.
+ */
+MappedFile::~MappedFile() {
+#if defined(VSCUUID_HAVE_MMAP)
+  if (mapped_) {
+    ::munmap(const_cast<char*>(data_), size_);
+  }
+#endif
+}
+
+}
@@ -0,0 +1,267 @@
+#include "vscuuid/name_cache.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace vscuuid {
+
+namespace {
+
+constexpr std::size_t kMaxShards = 256;
+constexpr std::size_t kMinShardCapacity = 16;
+constexpr uint32_t kEmpty = 0;
+
+inline uint64_t Mix(uint64_t value) {
+  value ^= value >> 33;
+  value *= 0xFF51AFD7ED558CCDULL;
+  value ^= value >> 33;
+  value *= 0xC4CEB9FE1A85EC53ULL;
+  value ^= value >> 33;
+  return value;
+}
+
+// Eight bytes at a time; the length is mixed in so that ("ab", "c") and
+// ("a", "bc") hash differently.
+inline uint64_t HashBytes(uint64_t hash, std::string_view text) {
+  hash = (hash ^ text.size()) * 0x9E3779B97F4A7C15ULL;
+  std::size_t i = 0;
+  for (; i + 8 <= text.size(); i += 8) {
+    uint64_t word;
+    std::memcpy(&word, text.data() + i, 8);
+    hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+    hash ^= hash >> 29;
+  }
+  if (i < text.size()) {
+    uint64_t word = 0;
+    std::memcpy(&word, text.data() + i, text.size() - i);
+    hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+    hash ^= hash >> 29;
+  }
+  return hash;
+}
+
+inline uint64_t HashKey(int version, std::string_view namespace_uuid, std::string_view name) {
+  return Mix(HashBytes(HashBytes(static_cast<uint64_t>(version), namespace_uuid), name));
+}
+
+}
+
+struct NameUuidCache::Shard {
+  struct Entry {
+    uint64_t hash = 0;
+    uint32_t namespace_size = 0;
+    uint32_t name_size = 0;
+    int version = 0;
+    // Set by hits under the shared lock, cleared by the clock hand.
+    std::atomic<bool> referenced{false};
+    Uuid uuid;
+    char inline_key[kInlineKeySize];
+    std::unique_ptr<char[]> long_key;
+
+    const char* key() const { return long_key ? long_key.get() : inline_key; }
+
+    bool Matches(uint64_t other_hash, int other_version, std::string_view namespace_uuid,
+                 std::string_view name) const {
+      return hash == other_hash && version == other_version && namespace_size == namespace_uuid.size() &&
+             name_size == name.size() && std::memcmp(key(), namespace_uuid.data(), namespace_size) == 0 &&
+             std::memcmp(key() + namespace_size, name.data(), name_size) == 0;
+    }
+  };
+
+  // Hits take the lock shared; only Insert and Clear change the structure.
+  alignas(64) std::shared_mutex mutex;
+  std::unique_ptr<Entry[]> entries;
+  // Open addressing with linear probing over entry index + 1; kEmpty marks a
+  // free bucket. At most half full, so probe sequences stay short.
+  std::vector<uint32_t> table;
+  std::size_t mask = 0;
+  std::size_t used = 0;
+  std::size_t hand = 0;
+  std::atomic<uint64_t> hits{0};
+  std::atomic<uint64_t> misses{0};
+  uint64_t evictions = 0;
+
+  std::size_t Find(uint64_t hash, int version, std::string_view namespace_uuid, std::string_view name) const {
+    for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+      if (table[i] == kEmpty || entries[table[i] - 1].Matches(hash, version, namespace_uuid, name)) {
+        return i;
+      }
+    }
+  }
+
+  // Backward-shift deletion keeps every remaining key reachable from its
+  // home bucket without tombstones.
+  void Unlink(std::size_t entry) {
+    std::size_t i = entries[entry].hash & mask;
+    while (table[i] != entry + 1) {
+      i = (i + 1) & mask;
+    }
+    for (std::size_t j = (i + 1) & mask; table[j] != kEmpty; j = (j + 1) & mask) {
+      std::size_t home = entries[table[j] - 1].hash & mask;
+      if (((j - home) & mask) >= ((j - i) & mask)) {
+        table[i] = table[j];
+        i = j;
+      }
+    }
+    table[i] = kEmpty;
+  }
+
+  // Sweeps the clock hand past referenced entries, clearing their bits, and
+  // returns the first unreferenced one.
+  std::size_t Victim(std::size_t capacity) {
+    while (entries[hand].referenced.load(std::memory_order_relaxed)) {
+      entries[hand].referenced.store(false, std::memory_order_relaxed);
+      hand = (hand + 1) % capacity;
+    }
+    std::size_t victim = hand;
+    hand = (hand + 1) % capacity;
+    return victim;
+  }
+};
+
+/**
+ * @brief Creates an empty cache.
+ *
+ * @param capacity The maximum number of entries; rounded up to a multiple of the shard count.
+ * @param shard_count The number of independently locked shards, rounded up to
+ *        a power of two; 0 picks four per hardware thread, fewer if that would
+ *        leave shards with under 16 entries.
+ * @throws std::invalid_argument if capacity is 0.
+ */
+NameUuidCache::NameUuidCache(std::size_t capacity, std::size_t shard_count) {
+  if (capacity == 0) {
+    throw std::invalid_argument("Name cache capacity must be positive");
+  }
+  if (shard_count == 0) {
+    shard_count = std::max(1u, std::thread::hardware_concurrency()) * 4;
+    shard_count = std::min(shard_count, std::max<std::size_t>(1, capacity / kMinShardCapacity));
+  }
+  shard_count_ = std::bit_ceil(std::min(shard_count, kMaxShards));
+  shard_capacity_ = (capacity + shard_count_ - 1) / shard_count_;
+  shard_shift_ = 64 - static_cast<unsigned>(std::countr_zero(shard_count_));
+  shards_ = std::make_unique<Shard[]>(shard_count_);
+  for (std::size_t s = 0; s < shard_count_; ++s) {
+    Shard& shard = shards_[s];
+    shard.entries = std::make_unique<Shard::Entry[]>(shard_capacity_);
+    shard.table.assign(std::bit_ceil(2 * shard_capacity_), kEmpty);
+    shard.mask = shard.table.size() - 1;
+  }
+}
+
+NameUuidCache::~NameUuidCache() = default;
+
+// The top hash bits pick the shard and the bottom bits the bucket, so the
+// two stay independent.
+NameUuidCache::Shard& NameUuidCache::ShardFor(uint64_t hash) const {
+  return shards_[shard_shift_ == 64 ? 0 : hash >> shard_shift_];
+}
+
+/**
+ * @brief Looks up a cached UUID.
+ *
+ * @param version The UUID version, 3 or 5.
+ * @param namespace_uuid The namespace exactly as given to the generator.
+ * @param name The name.
+ * @param out Receives the UUID on a hit.
+ * @return true on a hit.
+ *
+ * Runs under the shard's shared lock, so hits on the same shard proceed in
+ * parallel; a hit writes only the entry's reference bit, and only if unset.
+ */
+bool NameUuidCache::Lookup(int version, std::string_view namespace_uuid, std::string_view name, Uuid* out) {
+  const uint64_t hash = HashKey(version, namespace_uuid, name);
+  Shard& shard = ShardFor(hash);
+  std::shared_lock<std::shared_mutex> lock(shard.mutex);
+  const uint32_t index = shard.table[shard.Find(hash, version, namespace_uuid, name)];
+  if (index == kEmpty) {
+    shard.misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  Shard::Entry& entry = shard.entries[index - 1];
+  if (!entry.referenced.load(std::memory_order_relaxed)) {
+    entry.referenced.store(true, std::memory_order_relaxed);
+  }
+  *out = entry.uuid;
+  shard.hits.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+/**
+ * @brief Adds a UUID, evicting an entry of the same shard if it is full.
+ *
+ * Inserting a key that is already present leaves the cache unchanged, so
+ * threads that missed on the same name concurrently may all insert it.
+ */
+void NameUuidCache::Insert(int version, std::string_view namespace_uuid, std::string_view name, const Uuid& uuid) {
+  const uint64_t hash = HashKey(version, namespace_uuid, name);
+  const std::size_t key_size = namespace_uuid.size() + name.size();
+  std::unique_ptr<char[]> long_key;
+  if (key_size > kInlineKeySize) {
+    long_key = std::make_unique<char[]>(key_size);
+  }
+  Shard& shard = ShardFor(hash);
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  if (shard.table[shard.Find(hash, version, namespace_uuid, name)] != kEmpty) {
+    return;
+  }
+  std::size_t index;
+  if (shard.used < shard_capacity_) {
+    index = shard.used++;
+  } else {
+    index = shard.Victim(shard_capacity_);
+    shard.Unlink(index);
+    ++shard.evictions;
+  }
+  Shard::Entry& entry = shard.entries[index];
+  entry.hash = hash;
+  entry.version = version;
+  entry.namespace_size = static_cast<uint32_t>(namespace_uuid.size());
+  entry.name_size = static_cast<uint32_t>(name.size());
+  entry.referenced.store(false, std::memory_order_relaxed);
+  entry.uuid = uuid;
+  entry.long_key = std::move(long_key);
+  char* key = entry.long_key ? entry.long_key.get() : entry.inline_key;
+  std::memcpy(key, namespace_uuid.data(), namespace_uuid.size());
+  std::memcpy(key + namespace_uuid.size(), name.data(), name.size());
+  shard.table[shard.Find(hash, version, namespace_uuid, name)] = static_cast<uint32_t>(index + 1);
+}
+
+/**
+ * @brief Removes every entry; statistics are kept.
+ */
+void NameUuidCache::Clear() {
+  for (std::size_t s = 0; s < shard_count_; ++s) {
+    Shard& shard = shards_[s];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    std::fill(shard.table.begin(), shard.table.end(), kEmpty);
+    for (std::size_t i = 0; i < shard.used; ++i) {
+      shard.entries[i].long_key.reset();
+    }
+    shard.used = 0;
+    shard.hand = 0;
+  }
+}
+
+/**
+ * @brief Returns hit, miss and eviction counts summed over all shards.
+ */
+NameCacheStats NameUuidCache::stats() const {
+  NameCacheStats total;
+  for (std::size_t s = 0; s < shard_count_; ++s) {
+    Shard& shard = shards_[s];
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    total.hits += shard.hits.load(std::memory_order_relaxed);
+    total.misses += shard.misses.load(std::memory_order_relaxed);
+    total.evictions += shard.evictions;
+  }
+  return total;
+}
+
+}
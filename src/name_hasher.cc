@@ -0,0 +1,72 @@
+#include "name_hasher.hh"
+
+#include <algorithm>
+#include <array>
+#include <openssl/evp.h>
+#include <stdexcept>
+
+namespace vscuuid {
+
+/**
+ * @brief Prepares a reusable hasher for name-based UUIDs in one namespace.
+ *
+ * The namespace is absorbed into a prefix digest state once; each Hash() call
+ * copies that state instead of rehashing the namespace, and no context is
+ * allocated per name.
+ *
+ * @param version 3 (MD5) or 5 (SHA-1).
+ * @param namespace_uuid The namespace UUID as a string view.
+ * @throws std::invalid_argument if the version is not 3 or 5.
+ * @throws std::runtime_error if the digest contexts cannot be set up.
+ */
+NameHasher::NameHasher(int version, std::string_view namespace_uuid)
+    : version_(version), prefix_ctx_(EVP_MD_CTX_new()), ctx_(EVP_MD_CTX_new()) {
+  if (version != 3 && version != 5) {
+    EVP_MD_CTX_free(prefix_ctx_);
+    EVP_MD_CTX_free(ctx_);
+    throw std::invalid_argument("Name-based UUIDs must be version 3 or 5");
+  }
+  const EVP_MD* md = version == 3 ? EVP_md5() : EVP_sha1();
+  if (prefix_ctx_ == nullptr || ctx_ == nullptr ||
+      EVP_DigestInit_ex(prefix_ctx_, md, nullptr) != 1 ||
+      EVP_DigestUpdate(prefix_ctx_, namespace_uuid.data(), namespace_uuid.size()) != 1) {
+    EVP_MD_CTX_free(prefix_ctx_);
+    EVP_MD_CTX_free(ctx_);
+    throw std::runtime_error("Failed to create EVP_MD_CTX");
+  }
+}
+
+/**
+ * @brief Releases the digest contexts.
+ */
+NameHasher::~NameHasher() {
+  EVP_MD_CTX_free(prefix_ctx_);
+  EVP_MD_CTX_free(ctx_);
+}
+
+/**
+ * @brief Derives the name-based UUID for one name.
+ *
+ * The result is identical to UuidV3Generator/UuidV5Generator::GenerateUuid
+ * called with the same namespace and name.
+ *
+ * @param name The name to hash.
+ * @return The derived UUID.
+ * @throws std::runtime_error if the digest computation fails.
+ */
+Uuid NameHasher::Hash(std::string_view name) {
+  unsigned char hash[EVP_MAX_MD_SIZE];
+  unsigned int hash_len;
+  if (EVP_MD_CTX_copy_ex(ctx_, prefix_ctx_) != 1 ||
+      EVP_DigestUpdate(ctx_, name.data(), name.size()) != 1 ||
+      EVP_DigestFinal_ex(ctx_, hash, &hash_len) != 1) {
+    throw std::runtime_error("Failed to compute name hash");
+  }
+  std::array<uint8_t, 16> bytes;
+  std::copy(hash, hash + 16, bytes.begin());
+  bytes[6] = static_cast<uint8_t>((bytes[6] & 0x0F) | (version_ << 4));
+  bytes[8] = (bytes[8] & 0x3F) | 0x80;
+  return Uuid(bytes);
+}
+
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <openssl/evp.h>
+#include <string_view>
+#include "vscuuid/uuid.hh"
+
+namespace vscuuid {
+
+class NameHasher {
+ public:
+  NameHasher(int version, std::string_view namespace_uuid);
+  ~NameHasher();
+
+  NameHasher(const NameHasher&) = delete;
+  NameHasher& operator=(const NameHasher&) = delete;
+
+  Uuid Hash(std::string_view name);
+
+ private:
+  int version_;
+  EVP_MD_CTX* prefix_ctx_;
+  EVP_MD_CTX* ctx_;
+};
+
+}
@@ -0,0 +1,162 @@
+#include "vscuuid/name_pipeline.hh"
+#include "mapped_file.hh"
+#include "name_hasher.hh"
+#include "ordered_pipeline.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace vscuuid {
+
+namespace {
+
+struct LineBatch {
+  std::unique_ptr<NameHasher> hasher;
+  std::string output;
+  std::size_t lines = 0;
+};
+
+int NameBasedVersion(UuidFactory::UuidType type) {
+  switch (type) {
+    case UuidFactory::UuidType::V3:
+      return 3;
+    case UuidFactory::UuidType::V5:
+      return 5;
+    default:
+      throw std::invalid_argument("Name pipeline supports only UUID versions 3 and 5");
+  }
+}
+
+// Splits the input into batches of roughly batch_bytes that end on a line break.
+std::vector<std::size_t> SplitIntoBatches(std::string_view input, std::size_t batch_bytes) {
+  std::vector<std::size_t> boundaries{0};
+  std::size_t position = 0;
+  while (position < input.size()) {
+    std::size_t next = position + std::max<std::size_t>(batch_bytes, 1);
+    if (next >= input.size()) {
+      next = input.size();
+    } else {
+      const void* newline = std::memchr(input.data() + next, '\n', input.size() - next);
+      next = newline == nullptr ? input.size()
+                                : static_cast<std::size_t>(static_cast<const char*>(newline) - input.data()) + 1;
+    }
+    boundaries.push_back(next);
+    position = next;
+  }
+  return boundaries;
+}
+
+void HashBatch(std::string_view text, NameOutputFormat format, LineBatch& batch) {
+  constexpr std::size_t kBinaryRecord = 16;
+  batch.output.clear();
+  batch.lines = 0;
+  std::size_t position = 0;
+  while (position < text.size()) {
+    const void* newline = std::memchr(text.data() + position, '\n', text.size() - position);
+    std::size_t line_end = newline == nullptr ? text.size()
+                                              : static_cast<std::size_t>(static_cast<const char*>(newline) - text.data());
+    std::string_view name = text.substr(position, line_end - position);
+    if (!name.empty() && name.back() == '\r') {
+      name.remove_suffix(1);
+    }
+    Uuid uuid = batch.hasher->Hash(name);
+
+    std::size_t offset = batch.output.size();
+    if (format == NameOutputFormat::kBinary) {
+      batch.output.resize(offset + kBinaryRecord);
+      std::memcpy(batch.output.data() + offset, uuid.bytes().data(), kBinaryRecord);
+    } else {
+      batch.output.resize(offset + name.size() + kUuidStringLength + 2);
+      char* out = batch.output.data() + offset;
+      std::memcpy(out, name.data(), name.size());
+      out += name.size();
+      *out++ = ',';
+      uuid.FormatTo(std::span<char, kUuidStringLength>(out, kUuidStringLength));
+      out[kUuidStringLength] = '\n';
+    }
+    ++batch.lines;
+    position = line_end + 1;
+  }
+}
+
+}
+
+/**
+ * @brief Derives name-based UUIDs for every line of a text buffer.
+ *
+ * This runs a three-stage pipeline: the calling thread splits the input into
+ * line-aligned batches, a pool of workers hashes the lines of each batch, and
+ * the calling thread writes finished batches to the output in input order.
+ * Every worker reuses one digest context with the namespace pre-absorbed, and
+ * records are formatted straight into the batch buffer, so no allocation
+ * happens per line. At most max_batches_in_flight batches exist at once, so a
+ * slow output stream throttles the workers instead of growing memory.
+ *
+ * Text output is one "key,uuid" line per input line; binary output is the
+ * 16-byte UUIDs back to back. A trailing carriage return is not part of the key.
+ * Results are identical to calling UuidV5Generator::Generate(namespace_uuid, line)
+ * (or the V3 equivalent) for each line.
+ *
+ * @param input The newline-separated keys.
+ * @param namespace_uuid The namespace UUID as a string view.
+ * @param output The stream receiving the results.
+ * @param options Version, output format and parallelism settings.
+ * @return The number of lines processed.
+ * @throws std::invalid_argument if the requested type is not V3 or V5.
+ * @throws std::runtime_error if hashing or writing the output fails.
+ */
+std::size_t DeriveNameUuids(std::string_view input, std::string_view namespace_uuid,
+                            std::ostream& output, const NamePipelineOptions& options) {
+  const int version = NameBasedVersion(options.type);
+  const std::vector<std::size_t> boundaries = SplitIntoBatches(input, options.batch_bytes);
+  unsigned thread_count = options.thread_count;
+  if (thread_count == 0) {
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+  std::size_t window = options.max_batches_in_flight;
+  if (window == 0) {
+    window = 2 * static_cast<std::size_t>(thread_count);
+  }
+
+  std::size_t lines = 0;
+  RunOrderedPipeline<LineBatch>(
+      boundaries.size() - 1, thread_count, window,
+      [&](std::size_t index, LineBatch& batch) {
+        if (!batch.hasher) {
+          batch.hasher = std::make_unique<NameHasher>(version, namespace_uuid);
+        }
+        HashBatch(input.substr(boundaries[index], boundaries[index + 1] - boundaries[index]),
+                  options.format, batch);
+      },
+      [&](const LineBatch& batch) {
+        if (!output.write(batch.output.data(), static_cast<std::streamsize>(batch.output.size()))) {
+          throw std::runtime_error("Failed to write name pipeline output");
+        }
+        lines += batch.lines;
+      });
+  return lines;
+}
+
+/**
+ * @brief Derives name-based UUIDs for every line of a file.
+ *
+ * The file is memory mapped and processed by DeriveNameUuids().
+ *
+ * @param input_path The file of newline-separated keys.
+ * @param namespace_uuid The namespace UUID as a string view.
+ * @param output The stream receiving the results.
+ * @param options Version, output format and parallelism settings.
+ * @return The number of lines processed.
+ * @throws std::runtime_error if the file cannot be mapped or the pipeline fails.
+ */
+std::size_t DeriveNameUuidsFromFile(const std::string& input_path, std::string_view namespace_uuid,
+                                    std::ostream& output, const NamePipelineOptions& options) {
+  MappedFile file(input_path);
+  return DeriveNameUuids(file.view(), namespace_uuid, output, options);
+}
+
+}
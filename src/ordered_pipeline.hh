@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vscuuid {
+
+/**
+ * @brief Runs task_count tasks on a worker pool and consumes results in task order.
+ *
+ * Workers call produce(task, result) for increasing task indices; the calling
+ * thread calls consume(result) for task 0, 1, 2, ... as they complete. At most
+ * `window` results exist at any time, so a slow consumer applies back-pressure
+ * to the workers and memory stays bounded. Result objects are recycled between
+ * tasks, letting producers reuse their buffers. The first exception thrown by
+ * either side stops the pipeline and is rethrown once all workers have joined.
+ */
+template <typename Result, typename Produce, typename Consume>
+void RunOrderedPipeline(std::size_t task_count, unsigned thread_count, std::size_t window,
+                        Produce produce, Consume consume) {
+  if (task_count == 0) {
+    return;
+  }
+  thread_count = static_cast<unsigned>(std::clamp<std::size_t>(thread_count, 1, task_count));
+  window = std::max<std::size_t>(window, thread_count);
+
+  std::vector<Result> slots(window);
+  std::vector<char> ready(window, 0);
+  std::size_t next_task = 0;
+  std::size_t consumed = 0;
+  bool stop = false;
+  std::exception_ptr error;
+  std::mutex mutex;
+  std::condition_variable cv;
+
+  auto fail = [&](std::exception_ptr e) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!error) {
+      error = e;
+    }
+    stop = true;
+    cv.notify_all();
+  };
+
+  auto worker = [&]() {
+    Result local;
+    while (true) {
+      std::size_t task;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return stop || next_task >= task_count || next_task < consumed + window; });
+        if (stop || next_task >= task_count) {
+          return;
+        }
+        task = next_task++;
+      }
+      try {
+        produce(task, local);
+      } catch (...) {
+        fail(std::current_exception());
+        return;
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      std::swap(slots[task % window], local);
+      ready[task % window] = 1;
+      cv.notify_all();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(thread_count);
+  for (unsigned t = 0; t < thread_count; ++t) {
+    workers.emplace_back(worker);
+  }
+
+  Result current;
+  for (std::size_t task = 0; task < task_count; ++task) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [&] { return stop || ready[task % window] != 0; });
+      if (stop) {
+        break;
+      }
+      std::swap(current, slots[task % window]);
+      ready[task % window] = 0;
+      ++consumed;
+      cv.notify_all();
+    }
+    try {
+      consume(current);
+    } catch (...) {
+      fail(std::current_exception());
+      break;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+    cv.notify_all();
+  }
+  for (auto& thread : workers) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+}
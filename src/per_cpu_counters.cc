@@ -0,0 +1,203 @@
+#include "per_cpu_counters.hh"
+#include "vscuuid/per_cpu.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(__x86_64__) && defined(__GNUC__) && defined(__has_include)
+#if __has_include(<sys/rseq.h>)
+#include <sys/rseq.h>
+#define VSCUUID_HAVE_RSEQ 1
+#endif
+#endif
+
+namespace vscuuid {
+
+namespace {
+
+// Above this many possible CPUs the counters fall back to shared atomic slots.
+constexpr std::size_t kMaxRseqSlots = 4096;
+constexpr std::size_t kMaxAtomicSlots = 256;
+
+#if defined(VSCUUID_HAVE_RSEQ)
+
+struct rseq* RseqArea() {
+  return reinterpret_cast<struct rseq*>(static_cast<char*>(__builtin_thread_pointer()) + __rseq_offset);
+}
+
+// Only cpu_id and rseq_cs are used, which the original 20-byte ABI covers.
+bool RseqRegistered() {
+  return __rseq_size >= 16 && static_cast<int32_t>(RseqArea()->cpu_id) >= 0;
+}
+
+// Adds amount to *counter if the thread is still on `cpu` and is not
+// interrupted before the final store; returns false if the kernel aborted the
+// sequence. The descriptor in __rseq_cs tells the kernel where the critical
+// section starts (1), where it commits (2) and where to resume on abort (4);
+// the abort handler must be preceded by glibc's registered signature.
+inline bool RseqFetchAdd(uint64_t* counter, uint64_t amount, uint32_t cpu, uint64_t* previous) {
+  struct rseq* area = RseqArea();
+  asm goto(
+      ".pushsection __rseq_cs, \"aw\"\n\t"
+      ".balign 32\n\t"
+      "3:\n\t"
+      ".long 0, 0\n\t"
+      ".quad 1f, 2f - 1f, 4f\n\t"
+      ".popsection\n\t"
+      "leaq 3b(%%rip), %%rax\n\t"
+      "movq %%rax, 8(%[area])\n\t"
+      "1:\n\t"
+      "cmpl %[cpu], 4(%[area])\n\t"
+      "jnz 4f\n\t"
+      "movq %[counter], %%rax\n\t"
+      "movq %%rax, %[previous]\n\t"
+      "addq %[amount], %%rax\n\t"
+      "movq %%rax, %[counter]\n\t"
+      "2:\n\t"
+      ".pushsection __rseq_failure, \"ax\"\n\t"
+      ".byte 0x0f, 0xb9, 0x3d\n\t"
+      ".long 0x53053053\n\t"
+      "4:\n\t"
+      "jmp %l[aborted]\n\t"
+      ".popsection\n\t"
+      :
+      : [area] "r"(area), [cpu] "r"(cpu), [counter] "m"(*counter), [previous] "m"(*previous),
+        [amount] "r"(amount)
+      : "memory", "cc", "rax"
+      : aborted);
+  return true;
+aborted:
+  return false;
+}
+
+#endif
+
+// The highest possible CPU id plus one. The possible mask can be sparse, so
+// a CPU count is not enough to index slots by CPU id.
+std::size_t PossibleCpuSlots() {
+#if defined(__linux__)
+  std::ifstream possible("/sys/devices/system/cpu/possible");
+  std::string ranges;
+  if (std::getline(possible, ranges)) {
+    std::size_t highest = 0;
+    bool found = false;
+    for (const char* p = ranges.c_str(); *p != '\0';) {
+      char* end;
+      unsigned long cpu = std::strtoul(p, &end, 10);
+      if (end == p) {
+        ++p;
+        continue;
+      }
+      highest = std::max<std::size_t>(highest, cpu);
+      found = true;
+      p = end;
+    }
+    if (found) {
+      return highest + 1;
+    }
+  }
+  long count = ::sysconf(_SC_NPROCESSORS_CONF);
+  if (count > 0) {
+    return static_cast<std::size_t>(count);
+  }
+#endif
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+std::size_t CurrentCpuForAtomicSlot() {
+#if defined(__linux__)
+  int cpu = ::sched_getcpu();
+  if (cpu >= 0) {
+    return static_cast<std::size_t>(cpu);
+  }
+#endif
+  return std::hash<std::thread::id>()(std::this_thread::get_id());
+}
+
+}
+
+/**
+ * @brief Allocates one counter per possible CPU.
+ *
+ * The restartable-sequence path is used only when every possible CPU id has a
+ * slot of its own; a slot shared by two CPUs has to be updated atomically.
+ * Restartable sequences store to their slot without an atomic instruction, so
+ * in that mode one extra slot is reserved for threads that cannot use them and
+ * no slot is ever updated both ways.
+ *
+ * @param max_slots Caps the slot count for callers that encode the slot index
+ *        in a fixed number of bits; 0 applies only the built-in limits.
+ */
+PerCpuCounters::PerCpuCounters(std::size_t max_slots) : use_rseq_(UsesRseq()) {
+  std::size_t cpus = PossibleCpuSlots();
+  const std::size_t rseq_limit = max_slots == 0 ? kMaxRseqSlots : std::min(max_slots, kMaxRseqSlots);
+  const std::size_t atomic_limit = max_slots == 0 ? kMaxAtomicSlots : std::min(max_slots, kMaxAtomicSlots);
+  if (use_rseq_ && cpus + 1 > rseq_limit) {
+    use_rseq_ = false;
+  }
+  slot_count_ = use_rseq_ ? cpus + 1 : std::min(cpus, atomic_limit);
+  slots_ = std::make_unique<Slot[]>(slot_count_);
+}
+
+/**
+ * @brief Reports whether this thread can use restartable sequences.
+ */
+bool PerCpuCounters::UsesRseq() {
+#if defined(VSCUUID_HAVE_RSEQ)
+  return RseqRegistered();
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Adds to the calling CPU's counter.
+ *
+ * @param amount The value to add.
+ * @param slot Receives the index of the slot that was updated.
+ * @return The counter's value before the addition.
+ */
+uint64_t PerCpuCounters::FetchAdd(uint64_t amount, std::size_t* slot) {
+#if defined(VSCUUID_HAVE_RSEQ)
+  if (use_rseq_) {
+    struct rseq* area = RseqArea();
+    for (;;) {
+      uint32_t cpu = __atomic_load_n(&area->cpu_id, __ATOMIC_RELAXED);
+      // Unregistered threads read cpu_id as a negative value; the last slot
+      // is theirs alone.
+      if (cpu >= slot_count_ - 1) {
+        *slot = slot_count_ - 1;
+        return std::atomic_ref<uint64_t>(slots_[slot_count_ - 1].value).fetch_add(amount, std::memory_order_relaxed);
+      }
+      uint64_t previous;
+      if (RseqFetchAdd(&slots_[cpu].value, amount, cpu, &previous)) {
+        *slot = cpu;
+        return previous;
+      }
+    }
+  }
+#endif
+  std::size_t index = CurrentCpuForAtomicSlot() % slot_count_;
+  *slot = index;
+  return std::atomic_ref<uint64_t>(slots_[index].value).fetch_add(amount, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Reports whether per-CPU state is updated with Linux restartable
+ * sequences rather than atomic instructions.
+ */
+bool PerCpuUsesRseq() {
+  return PerCpuCounters::UsesRseq();
+}
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace vscuuid {
+
+// An array of counters, one per CPU, each on its own cache line. On Linux
+// x86-64 with glibc's rseq registration the calling CPU's counter is updated
+// inside a restartable sequence: a plain load/add/store that the kernel
+// restarts if the thread is preempted or migrated, so slots never need atomic
+// instructions and their cache lines never leave their CPU; threads without
+// an rseq registration share one extra slot that is updated atomically.
+// Elsewhere the slot is chosen with sched_getcpu() (or the thread id) and
+// updated atomically.
+class PerCpuCounters {
+ public:
+  explicit PerCpuCounters(std::size_t max_slots = 0);
+
+  std::size_t slot_count() const { return slot_count_; }
+  uint64_t FetchAdd(uint64_t amount, std::size_t* slot);
+
+  static bool UsesRseq();
+
+ private:
+  struct alignas(64) Slot {
+    uint64_t value = 0;
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  std::size_t slot_count_;
+  bool use_rseq_;
+};
+
+}
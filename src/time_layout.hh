@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "vscuuid/uuid.hh"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define VSCUUID_ALWAYS_INLINE __attribute__((always_inline)) inline
+#else
+#define VSCUUID_ALWAYS_INLINE inline
+#endif
+
+namespace vscuuid {
+
+// Bit manipulation on the first eight bytes of a time-based UUID, read as a
+// big-endian integer. The templates accept either uint64_t or a vector of
+// uint64_t, so the scalar and SIMD kernels share one definition; they are
+// force-inlined so vector instantiations take on the caller's ISA. Byte order
+// is the kernels' business: each ISA swaps it with its own shuffle.
+//
+//   V1: time_low(32) time_mid(16) version(4) time_high(12)
+//   V6: time_high(32) time_mid(16) version(4) time_low(12)
+
+template <typename T>
+VSCUUID_ALWAYS_INLINE T V1HighToTimestamp(T high) {
+  return ((high & 0xFFF) << 48) | (((high >> 16) & 0xFFFF) << 32) | (high >> 32);
+}
+
+template <typename T>
+VSCUUID_ALWAYS_INLINE T V6HighToTimestamp(T high) {
+  return ((high >> 32) << 28) | (((high >> 16) & 0xFFFF) << 12) | (high & 0xFFF);
+}
+
+template <typename T>
+VSCUUID_ALWAYS_INLINE T TimestampToV1High(T timestamp) {
+  return ((timestamp & 0xFFFFFFFF) << 32) | (((timestamp >> 32) & 0xFFFF) << 16) | 0x1000 |
+         ((timestamp >> 48) & 0xFFF);
+}
+
+template <typename T>
+VSCUUID_ALWAYS_INLINE T TimestampToV6High(T timestamp) {
+  return (((timestamp >> 28) & 0xFFFFFFFF) << 32) | (((timestamp >> 12) & 0xFFFF) << 16) | 0x6000 |
+         (timestamp & 0xFFF);
+}
+
+inline uint64_t LoadBigEndian64(const uint8_t* bytes) {
+  uint64_t value = 0;
+  for (int i = 0; i < 8; ++i) {
+    value = (value << 8) | bytes[i];
+  }
+  return value;
+}
+
+inline void StoreBigEndian64(uint64_t value, uint8_t* bytes) {
+  for (int i = 7; i >= 0; --i) {
+    bytes[i] = static_cast<uint8_t>(value);
+    value >>= 8;
+  }
+}
+
+template <bool kToV6>
+inline void ConvertTimeLayoutScalar(const Uuid* in, std::size_t count, Uuid* out) {
+  for (std::size_t i = 0; i < count; ++i) {
+    Uuid uuid = in[i];
+    uint64_t high = LoadBigEndian64(uuid.bytes().data());
+    high = kToV6 ? TimestampToV6High(V1HighToTimestamp(high)) : TimestampToV1High(V6HighToTimestamp(high));
+    StoreBigEndian64(high, uuid.bytes().data());
+    out[i] = uuid;
+  }
+}
+
+}
@@ -0,0 +1,171 @@
+#include "vscuuid/uuid.hh"
+#include "cpu_dispatch.hh"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace vscuuid {
+
+namespace {
+
+constexpr char kHexDigits[] = "0123456789abcdef";
+
+constexpr std::array<uint16_t, 256> MakeHexPairTable() {
+  std::array<uint16_t, 256> table{};
+  for (int i = 0; i < 256; ++i) {
+    table[i] = static_cast<uint16_t>((kHexDigits[i >> 4] << 8) | kHexDigits[i & 0xF]);
+  }
+  return table;
+}
+
+constexpr std::array<uint8_t, 256> MakeNibbleTable() {
+  std::array<uint8_t, 256> table{};
+  for (auto& entry : table) {
+    entry = 0xFF;
+  }
+  for (int c = '0'; c <= '9'; ++c) table[c] = static_cast<uint8_t>(c - '0');
+  for (int c = 'a'; c <= 'f'; ++c) table[c] = static_cast<uint8_t>(c - 'a' + 10);
+  for (int c = 'A'; c <= 'F'; ++c) table[c] = static_cast<uint8_t>(c - 'A' + 10);
+  return table;
+}
+
+constexpr auto kHexPairs = MakeHexPairTable();
+constexpr auto kNibbles = MakeNibbleTable();
+
+// Offset of the first hex digit of each byte within the 8-4-4-4-12 text form.
+constexpr std::array<uint8_t, 16> kTextOffsets = {0,  2,  4,  6,  9,  11, 14, 16,
+                                                  19, 21, 24, 26, 28, 30, 32, 34};
+
+}
+
+/**
+ * @brief Writes the canonical 8-4-4-4-12 lower-case form into a caller buffer.
+ *
+ * No terminating null character is written and no memory is allocated, which
+ * makes this the building block for every other text conversion.
+ *
+ * @param out Destination for exactly 36 characters.
+ */
+void Uuid::FormatTo(std::span<char, kUuidStringLength> out) const noexcept {
+  for (std::size_t i = 0; i < 16; ++i) {
+    uint16_t pair = kHexPairs[bytes_[i]];
+    out[kTextOffsets[i]] = static_cast<char>(pair >> 8);
+    out[kTextOffsets[i] + 1] = static_cast<char>(pair & 0xFF);
+  }
+  out[8] = '-';
+  out[13] = '-';
+  out[18] = '-';
+  out[23] = '-';
+}
+
+/**
+ * @brief Formats the UUID into a fixed-capacity inline string.
+ *
+ * @return A null-terminated UuidString that lives entirely on the stack.
+ */
+UuidString Uuid::ToUuidString() const {
+  UuidString text;
+  FormatTo(text.span());
+  return text;
+}
+
+/**
+ * @brief Formats the UUID into a std::string.
+ *
+ * @return The canonical 36 character representation.
+ */
+std::string Uuid::ToString() const {
+  return ToUuidString().str();
+}
+
+/**
+ * @brief Parses the canonical 8-4-4-4-12 form without throwing.
+ *
+ * Upper- and lower-case hexadecimal digits are accepted.
+ *
+ * @param text The text to parse; it must be exactly 36 characters long.
+ * @param out Receives the parsed value on success and is untouched otherwise.
+ * @return true if the text was a well-formed UUID.
+ */
+bool Uuid::TryParse(std::string_view text, Uuid* out) noexcept {
+  if (text.size() != kUuidStringLength || text[8] != '-' || text[13] != '-' ||
+      text[18] != '-' || text[23] != '-') {
+    return false;
+  }
+  std::array<uint8_t, 16> bytes;
+  uint8_t invalid = 0;
+  for (std::size_t i = 0; i < 16; ++i) {
+    uint8_t hi = kNibbles[static_cast<unsigned char>(text[kTextOffsets[i]])];
+    uint8_t lo = kNibbles[static_cast<unsigned char>(text[kTextOffsets[i] + 1])];
+    invalid |= hi | lo;
+    bytes[i] = static_cast<uint8_t>((hi << 4) | (lo & 0xF));
+  }
+  if (invalid & 0xF0) {
+    return false;
+  }
+  *out = Uuid(bytes);
+  return true;
+}
+
+/**
+ * @brief Parses the canonical 8-4-4-4-12 form.
+ *
+ * @param text The text to parse.
+ * @return The parsed UUID.
+ * @throws std::invalid_argument if the text is not a well-formed UUID.
+ */
+Uuid Uuid::Parse(std::string_view text) {
+  Uuid uuid;
+  if (!TryParse(text, &uuid)) {
+    throw std::invalid_argument("Invalid UUID format");
+  }
+  return uuid;
+}
+
+/**
+ * @brief Streams the canonical form without creating a temporary string.
+ */
+std::ostream& operator<<(std::ostream& os, const Uuid& uuid) {
+  return os << uuid.ToUuidString();
+}
+
+/**
+ * @brief Streams the characters held by a UuidString.
+ */
+std::ostream& operator<<(std::ostream& os, const UuidString& text) {
+  return os.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+/**
+ * @brief Formats many UUIDs as back-to-back 36 character records.
+ *
+ * No separators or terminators are written. The work is done by the widest
+ * kernel the CPU supports (see cpu_features.hh).
+ *
+ * @param uuids The values to format.
+ * @param out Receives uuids.size() * kUuidStringLength characters.
+ * @throws std::invalid_argument if out is too small.
+ */
+void FormatUuids(std::span<const Uuid> uuids, std::span<char> out) {
+  if (out.size() / kUuidStringLength < uuids.size()) {
+    throw std::invalid_argument("Output buffer too small for formatted UUIDs");
+  }
+  kernels::Active().format(uuids.data(), uuids.size(), out.data());
+}
+
+/**
+ * @brief Parses back-to-back 36 character records, the inverse of FormatUuids().
+ *
+ * Parsing stops at the first malformed record or when out is full; trailing
+ * characters that do not form a whole record are ignored.
+ *
+ * @param text The records to parse.
+ * @param out Receives the parsed values.
+ * @return The number of records parsed.
+ */
+std::size_t ParseUuids(std::span<const char> text, std::span<Uuid> out) {
+  std::size_t count = std::min(text.size() / kUuidStringLength, out.size());
+  return kernels::Active().parse(text.data(), count, out.data());
+}
+
+}
@@ -0,0 +1,362 @@
+#include "vscuuid/uuid_codec.hh"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace vscuuid {
+
+namespace {
+
+constexpr char kCodecMagic[8] = {'V', 'S', 'C', 'U', 'D', 'L', 'T', '1'};
+constexpr std::size_t kHeaderSize = 16;
+constexpr std::size_t kDirectoryEntrySize = 16;
+
+inline uint64_t LoadLittleEndian64(const uint8_t* bytes) {
+  uint64_t value;
+  std::memcpy(&value, bytes, sizeof(value));
+  if constexpr (std::endian::native == std::endian::big) {
+    value = std::byteswap(value);
+  }
+  return value;
+}
+
+inline void StoreLittleEndian64(uint8_t* bytes, uint64_t value) {
+  if constexpr (std::endian::native == std::endian::big) {
+    value = std::byteswap(value);
+  }
+  std::memcpy(bytes, &value, sizeof(value));
+}
+
+inline uint64_t LoadBigEndian64(const uint8_t* bytes) {
+  uint64_t value;
+  std::memcpy(&value, bytes, sizeof(value));
+  if constexpr (std::endian::native == std::endian::little) {
+    value = std::byteswap(value);
+  }
+  return value;
+}
+
+inline void StoreBigEndian64(uint8_t* bytes, uint64_t value) {
+  if constexpr (std::endian::native == std::endian::little) {
+    value = std::byteswap(value);
+  }
+  std::memcpy(bytes, &value, sizeof(value));
+}
+
+// A block of kBits-wide deltas occupies exactly 2 * kBits words, whatever
+// kBits is, because it always packs 128 values (the last block is padded).
+inline std::size_t PackedSize(unsigned bits) {
+  return 2 * bits * sizeof(uint64_t);
+}
+
+template <unsigned kBits>
+constexpr uint64_t kMask = kBits == 64 ? ~uint64_t{0} : (uint64_t{1} << kBits) - 1;
+
+// Delta I lives at bit I * kBits of the packed words. With the width and
+// index known at compile time, every word offset and shift is a constant and
+// unpacking a block is straight-line code without branches.
+template <unsigned kBits, std::size_t I>
+inline void PackOne(const uint64_t* deltas, uint64_t* words) {
+  constexpr std::size_t kBit = I * kBits;
+  constexpr std::size_t kWord = kBit / 64;
+  constexpr unsigned kShift = kBit % 64;
+  words[kWord] |= deltas[I] << kShift;
+  if constexpr (kShift + kBits > 64) {
+    words[kWord + 1] |= deltas[I] >> (64 - kShift);
+  }
+}
+
+template <unsigned kBits, std::size_t I>
+inline uint64_t UnpackOne(const uint8_t* packed) {
+  constexpr std::size_t kBit = I * kBits;
+  constexpr std::size_t kWord = kBit / 64;
+  constexpr unsigned kShift = kBit % 64;
+  uint64_t value = LoadLittleEndian64(packed + kWord * 8) >> kShift;
+  if constexpr (kShift + kBits > 64) {
+    value |= LoadLittleEndian64(packed + (kWord + 1) * 8) << (64 - kShift);
+  }
+  return value & kMask<kBits>;
+}
+
+template <unsigned kBits>
+void PackBlock(const uint64_t* deltas, uint8_t* packed) {
+  if constexpr (kBits > 0) {
+    uint64_t words[2 * kBits] = {};
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      (PackOne<kBits, I>(deltas, words), ...);
+    }(std::make_index_sequence<kCodecBlockSize>{});
+    for (std::size_t w = 0; w < 2 * kBits; ++w) {
+      StoreLittleEndian64(packed + w * 8, words[w]);
+    }
+  }
+}
+
+// Unpacks the deltas and turns them back into absolute values in one pass.
+template <unsigned kBits>
+void UnpackBlock(const uint8_t* packed, uint64_t base, uint64_t* highs) {
+  if constexpr (kBits == 0) {
+    std::fill_n(highs, kCodecBlockSize, base);
+  } else {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      ((base += UnpackOne<kBits, I>(packed), highs[I] = base), ...);
+    }(std::make_index_sequence<kCodecBlockSize>{});
+  }
+}
+
+using PackFunction = void (*)(const uint64_t*, uint8_t*);
+using UnpackFunction = void (*)(const uint8_t*, uint64_t, uint64_t*);
+
+template <std::size_t... kBits>
+constexpr std::array<PackFunction, sizeof...(kBits)> MakePackers(std::index_sequence<kBits...>) {
+  return {&PackBlock<kBits>...};
+}
+
+template <std::size_t... kBits>
+constexpr std::array<UnpackFunction, sizeof...(kBits)> MakeUnpackers(std::index_sequence<kBits...>) {
+  return {&UnpackBlock<kBits>...};
+}
+
+constexpr auto kPackers = MakePackers(std::make_index_sequence<65>{});
+constexpr auto kUnpackers = MakeUnpackers(std::make_index_sequence<65>{});
+
+struct BlockView {
+  uint64_t first_high;
+  unsigned bits;
+  const uint8_t* packed;
+  const uint8_t* lows;
+  std::size_t count;
+};
+
+BlockView ViewBlock(const std::vector<uint8_t>& bytes, std::size_t size, std::size_t block) {
+  const uint8_t* entry = bytes.data() + kHeaderSize + block * kDirectoryEntrySize;
+  const uint8_t* start = bytes.data() + LoadLittleEndian64(entry + 8);
+  BlockView view;
+  view.first_high = LoadLittleEndian64(entry);
+  view.bits = static_cast<unsigned>(LoadLittleEndian64(start));
+  view.packed = start + 8;
+  view.lows = view.packed + PackedSize(view.bits);
+  view.count = std::min(kCodecBlockSize, size - block * kCodecBlockSize);
+  return view;
+}
+
+void DecodeView(const BlockView& view, Uuid* out) {
+  uint64_t highs[kCodecBlockSize];
+  kUnpackers[view.bits](view.packed, view.first_high, highs);
+  for (std::size_t i = 0; i < view.count; ++i) {
+    StoreBigEndian64(out[i].bytes().data(), highs[i]);
+    std::memcpy(out[i].bytes().data() + 8, view.lows + i * 8, 8);
+  }
+}
+
+}
+
+/**
+ * @brief Compresses a sorted run of UUIDs.
+ *
+ * Each block of 128 UUIDs records its first high word in the directory and
+ * the differences between consecutive high words packed at the smallest
+ * width that holds the largest one, in the style of SIMD-BP128. Time-ordered
+ * UUIDs generated close together differ by a few bits there, so a V6 or V7
+ * stream shrinks to little more than its 8 raw low bytes per UUID.
+ *
+ * @param sorted The UUIDs in ascending order; duplicates are allowed.
+ * @return The compressed run.
+ * @throws std::invalid_argument if the UUIDs are not sorted.
+ */
+CompressedUuids CompressedUuids::Encode(std::span<const Uuid> sorted) {
+  for (std::size_t i = 1; i < sorted.size(); ++i) {
+    if (sorted[i] < sorted[i - 1]) {
+      throw std::invalid_argument("UUIDs must be sorted before they are compressed");
+    }
+  }
+  CompressedUuids result;
+  result.size_ = sorted.size();
+  const std::size_t blocks = result.block_count();
+  std::vector<uint8_t>& bytes = result.bytes_;
+  bytes.reserve(kHeaderSize + blocks * (kDirectoryEntrySize + 8) + sorted.size() * 8);
+  bytes.resize(kHeaderSize + blocks * kDirectoryEntrySize);
+  std::memcpy(bytes.data(), kCodecMagic, sizeof(kCodecMagic));
+  StoreLittleEndian64(bytes.data() + 8, sorted.size());
+
+  uint64_t deltas[kCodecBlockSize];
+  for (std::size_t block = 0; block < blocks; ++block) {
+    const std::size_t begin = block * kCodecBlockSize;
+    const std::size_t count = std::min(kCodecBlockSize, sorted.size() - begin);
+    const uint64_t first_high = LoadBigEndian64(sorted[begin].bytes().data());
+    uint64_t previous = first_high;
+    uint64_t all_bits = 0;
+    for (std::size_t i = 0; i < kCodecBlockSize; ++i) {
+      uint64_t high = i < count ? LoadBigEndian64(sorted[begin + i].bytes().data()) : previous;
+      deltas[i] = high - previous;
+      all_bits |= deltas[i];
+      previous = high;
+    }
+    const unsigned bits = static_cast<unsigned>(std::bit_width(all_bits));
+
+    uint8_t* entry = bytes.data() + kHeaderSize + block * kDirectoryEntrySize;
+    StoreLittleEndian64(entry, first_high);
+    StoreLittleEndian64(entry + 8, bytes.size());
+    const std::size_t offset = bytes.size();
+    bytes.resize(offset + 8 + PackedSize(bits) + count * 8);
+    StoreLittleEndian64(bytes.data() + offset, bits);
+    kPackers[bits](deltas, bytes.data() + offset + 8);
+    uint8_t* lows = bytes.data() + offset + 8 + PackedSize(bits);
+    for (std::size_t i = 0; i < count; ++i) {
+      std::memcpy(lows + i * 8, sorted[begin + i].bytes().data() + 8, 8);
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Restores a compressed run from the bytes returned by bytes().
+ *
+ * The encoding is independent of the host byte order. The bytes are copied
+ * and every directory entry is checked, so corrupt input cannot make later
+ * calls read out of bounds.
+ *
+ * @param bytes The encoded run.
+ * @return The compressed run.
+ * @throws std::runtime_error if the bytes are not a valid encoding.
+ */
+CompressedUuids CompressedUuids::FromBytes(std::span<const uint8_t> bytes) {
+  if (bytes.size() < kHeaderSize || std::memcmp(bytes.data(), kCodecMagic, sizeof(kCodecMagic)) != 0) {
+    throw std::runtime_error("Invalid compressed UUID data");
+  }
+  const uint64_t size = LoadLittleEndian64(bytes.data() + 8);
+  const uint64_t blocks = size / kCodecBlockSize + (size % kCodecBlockSize != 0 ? 1 : 0);
+  if (blocks > (bytes.size() - kHeaderSize) / kDirectoryEntrySize) {
+    throw std::runtime_error("Truncated compressed UUID data");
+  }
+  std::size_t expected = kHeaderSize + blocks * kDirectoryEntrySize;
+  for (uint64_t block = 0; block < blocks; ++block) {
+    const uint64_t offset = LoadLittleEndian64(bytes.data() + kHeaderSize + block * kDirectoryEntrySize + 8);
+    if (offset != expected || bytes.size() - offset < 8) {
+      throw std::runtime_error("Corrupt compressed UUID block directory");
+    }
+    const uint64_t bits = LoadLittleEndian64(bytes.data() + offset);
+    const std::size_t count = std::min<uint64_t>(kCodecBlockSize, size - block * kCodecBlockSize);
+    if (bits > 64 || bytes.size() - offset - 8 < PackedSize(static_cast<unsigned>(bits)) + count * 8) {
+      throw std::runtime_error("Corrupt compressed UUID block");
+    }
+    expected = offset + 8 + PackedSize(static_cast<unsigned>(bits)) + count * 8;
+  }
+  if (expected != bytes.size()) {
+    throw std::runtime_error("Trailing bytes after compressed UUID data");
+  }
+  CompressedUuids result;
+  result.bytes_.assign(bytes.begin(), bytes.end());
+  result.size_ = static_cast<std::size_t>(size);
+  return result;
+}
+
+/**
+ * @brief Decompresses the whole run.
+ *
+ * @param out Receives size() UUIDs.
+ * @throws std::invalid_argument if out is smaller than size().
+ */
+void CompressedUuids::Decode(std::span<Uuid> out) const {
+  if (out.size() < size_) {
+    throw std::invalid_argument("Output span is smaller than the compressed run");
+  }
+  for (std::size_t block = 0; block < block_count(); ++block) {
+    DecodeView(ViewBlock(bytes_, size_, block), out.data() + block * kCodecBlockSize);
+  }
+}
+
+/**
+ * @brief Decompresses a single block.
+ *
+ * @param block The block index, below block_count().
+ * @param out Receives the block's UUIDs; kCodecBlockSize entries always suffice.
+ * @return The number of UUIDs written.
+ * @throws std::out_of_range if block is out of range.
+ * @throws std::invalid_argument if out is smaller than the block.
+ */
+std::size_t CompressedUuids::DecodeBlock(std::size_t block, std::span<Uuid> out) const {
+  if (block >= block_count()) {
+    throw std::out_of_range("Compressed UUID block index out of range");
+  }
+  const BlockView view = ViewBlock(bytes_, size_, block);
+  if (out.size() < view.count) {
+    throw std::invalid_argument("Output span is smaller than the block");
+  }
+  DecodeView(view, out.data());
+  return view.count;
+}
+
+/**
+ * @brief Returns the UUID at a position, decoding only its block.
+ *
+ * @throws std::out_of_range if index is not below size().
+ */
+Uuid CompressedUuids::At(std::size_t index) const {
+  if (index >= size_) {
+    throw std::out_of_range("Compressed UUID index out of range");
+  }
+  const BlockView view = ViewBlock(bytes_, size_, index / kCodecBlockSize);
+  const std::size_t offset = index % kCodecBlockSize;
+  uint64_t highs[kCodecBlockSize];
+  kUnpackers[view.bits](view.packed, view.first_high, highs);
+  Uuid uuid;
+  StoreBigEndian64(uuid.bytes().data(), highs[offset]);
+  std::memcpy(uuid.bytes().data() + 8, view.lows + offset * 8, 8);
+  return uuid;
+}
+
+/**
+ * @brief Finds the position of the first UUID not less than the given one.
+ *
+ * The directory is binary searched on the first high word of each block, so
+ * normally a single block is decoded.
+ *
+ * @return A position in [0, size()].
+ */
+std::size_t CompressedUuids::LowerBound(const Uuid& uuid) const {
+  const std::size_t blocks = block_count();
+  const uint64_t high = LoadBigEndian64(uuid.bytes().data());
+  auto first_high = [&](std::size_t block) {
+    return LoadLittleEndian64(bytes_.data() + kHeaderSize + block * kDirectoryEntrySize);
+  };
+  // The first block starting at or above high; equal high words may also end
+  // the block before it.
+  std::size_t low = 0;
+  std::size_t count = blocks;
+  while (count > 0) {
+    std::size_t half = count / 2;
+    if (first_high(low + half) < high) {
+      low += half + 1;
+      count -= half + 1;
+    } else {
+      count = half;
+    }
+  }
+  Uuid decoded[kCodecBlockSize];
+  for (std::size_t block = low > 0 ? low - 1 : 0; block < blocks; ++block) {
+    if (block >= low && first_high(block) > high) {
+      return block * kCodecBlockSize;
+    }
+    const BlockView view = ViewBlock(bytes_, size_, block);
+    DecodeView(view, decoded);
+    std::size_t position = static_cast<std::size_t>(std::lower_bound(decoded, decoded + view.count, uuid) - decoded);
+    if (position < view.count) {
+      return block * kCodecBlockSize + position;
+    }
+  }
+  return size_;
+}
+
+/**
+ * @brief Tests whether a UUID is part of the run.
+ */
+bool CompressedUuids::Contains(const Uuid& uuid) const {
+  std::size_t position = LowerBound(uuid);
+  return position < size_ && At(position) == uuid;
+}
+
+}
@@ -0,0 +1,182 @@
+#include "vscuuid/uuid_columns.hh"
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace vscuuid {
+
+namespace {
+
+constexpr std::size_t kUuidBytes = sizeof(Uuid);
+
+bool BitIsSet(std::span<const uint8_t> bitmap, std::size_t index) {
+  return (bitmap[index / 8] >> (index % 8)) & 1;
+}
+
+// Formats the slots in [begin, end); null slots are left as spaces.
+void FormatRange(const Uuid* uuids, std::span<const uint8_t> validity, std::size_t begin, std::size_t end,
+                 char* out) {
+  if (validity.empty()) {
+    FormatUuids(std::span<const Uuid>(uuids + begin, end - begin),
+                std::span<char>(out + begin * kUuidStringLength, (end - begin) * kUuidStringLength));
+    return;
+  }
+  std::size_t run_begin = begin;
+  while (run_begin < end) {
+    std::size_t run_end = run_begin;
+    bool valid = BitIsSet(validity, run_begin);
+    while (run_end < end && BitIsSet(validity, run_end) == valid) {
+      ++run_end;
+    }
+    if (valid) {
+      FormatRange(uuids, {}, run_begin, run_end, out);
+    } else {
+      std::memset(out + run_begin * kUuidStringLength, ' ', (run_end - run_begin) * kUuidStringLength);
+    }
+    run_begin = run_end;
+  }
+}
+
+}
+
+/**
+ * @brief Allocates a zero-filled buffer aligned and padded to kColumnAlignment.
+ *
+ * @param size The logical size in bytes.
+ */
+AlignedBuffer::AlignedBuffer(std::size_t size)
+    : size_(size), capacity_((size + kColumnAlignment - 1) / kColumnAlignment * kColumnAlignment) {
+  if (capacity_ != 0) {
+    data_.reset(static_cast<uint8_t*>(::operator new(capacity_, std::align_val_t{kColumnAlignment})));
+    std::memset(data_.get(), 0, capacity_);
+  }
+}
+
+/**
+ * @brief Releases memory obtained from the aligned operator new.
+ */
+void AlignedBuffer::Deleter::operator()(uint8_t* data) const {
+  ::operator delete(data, std::align_val_t{kColumnAlignment});
+}
+
+/**
+ * @brief Views the values buffer as UUIDs.
+ */
+std::span<const Uuid> UuidColumn::uuids() const {
+  return std::span<const Uuid>(reinterpret_cast<const Uuid*>(values.data()), length);
+}
+
+/**
+ * @brief Reports whether a slot holds a value, following Arrow's validity bitmap rules.
+ */
+bool UuidColumn::IsValid(std::size_t index) const {
+  return validity.empty() || BitIsSet(validity.span(), index);
+}
+
+/**
+ * @brief Marks a slot as null and zeroes its value.
+ *
+ * The validity bitmap is allocated, all valid, on the first call.
+ *
+ * @throws std::out_of_range if index is not below length.
+ */
+void UuidColumn::SetNull(std::size_t index) {
+  if (index >= length) {
+    throw std::out_of_range("Column index out of range");
+  }
+  if (validity.empty()) {
+    validity = AlignedBuffer((length + 7) / 8);
+    std::memset(validity.data(), 0xFF, validity.size());
+    if (length % 8 != 0) {
+      validity.data()[validity.size() - 1] = static_cast<uint8_t>((1u << (length % 8)) - 1);
+    }
+  }
+  if (IsValid(index)) {
+    validity.data()[index / 8] &= static_cast<uint8_t>(~(1u << (index % 8)));
+    std::memset(values.data() + index * kUuidBytes, 0, kUuidBytes);
+    ++null_count;
+  }
+}
+
+/**
+ * @brief Returns the text of one slot.
+ */
+std::string_view UuidTextColumn::operator[](std::size_t index) const {
+  return std::string_view(reinterpret_cast<const char*>(chars.data()) + index * kUuidStringLength,
+                          kUuidStringLength);
+}
+
+/**
+ * @brief Generates a column of UUIDs into a newly allocated, 64-byte aligned buffer.
+ *
+ * The values are produced by one GenerateUuids() call, so generators with a
+ * batch path fill the column in bulk.
+ *
+ * @param generator The generator to draw from.
+ * @param length The number of UUIDs.
+ * @return A column with every slot valid.
+ */
+UuidColumn GenerateUuidColumn(UuidGeneratorBase& generator, std::size_t length) {
+  UuidColumn column;
+  column.length = length;
+  column.values = AlignedBuffer(length * kUuidBytes);
+  GenerateUuidColumn(generator, column.values.span());
+  return column;
+}
+
+/**
+ * @brief Generates UUIDs into a caller-provided FixedSizeBinary(16) data buffer.
+ *
+ * @param generator The generator to draw from.
+ * @param values The destination; its size must be a multiple of 16 bytes.
+ * @throws std::invalid_argument if the size is not a multiple of 16.
+ */
+void GenerateUuidColumn(UuidGeneratorBase& generator, std::span<uint8_t> values) {
+  if (values.size() % kUuidBytes != 0) {
+    throw std::invalid_argument("Column buffer size must be a multiple of 16 bytes");
+  }
+  generator.GenerateUuids(std::span<Uuid>(reinterpret_cast<Uuid*>(values.data()), values.size() / kUuidBytes));
+}
+
+/**
+ * @brief Formats a binary column into a newly allocated fixed-stride text column.
+ *
+ * Null slots are filled with spaces.
+ */
+UuidTextColumn FormatUuidColumn(const UuidColumn& column) {
+  UuidTextColumn text;
+  text.length = column.length;
+  text.chars = AlignedBuffer(column.length * kUuidStringLength);
+  FormatUuidColumn(column.values.span(), column.validity.span(),
+                   std::span<char>(reinterpret_cast<char*>(text.chars.data()), text.chars.size()));
+  return text;
+}
+
+/**
+ * @brief Formats caller-provided FixedSizeBinary(16) buffers into a caller-provided text column.
+ *
+ * Runs of valid slots go through the vectorized FormatUuids(); null slots are
+ * filled with spaces.
+ *
+ * @param values The data buffer; its size must be a multiple of 16 bytes.
+ * @param validity The validity bitmap, or an empty span if every slot is valid.
+ * @param out Receives kUuidStringLength characters per slot.
+ * @throws std::invalid_argument if a buffer is too small or values is not a multiple of 16.
+ */
+void FormatUuidColumn(std::span<const uint8_t> values, std::span<const uint8_t> validity,
+                      std::span<char> out) {
+  if (values.size() % kUuidBytes != 0) {
+    throw std::invalid_argument("Column buffer size must be a multiple of 16 bytes");
+  }
+  std::size_t length = values.size() / kUuidBytes;
+  if (out.size() / kUuidStringLength < length) {
+    throw std::invalid_argument("Output buffer too small for formatted UUIDs");
+  }
+  if (!validity.empty() && validity.size() < (length + 7) / 8) {
+    throw std::invalid_argument("Validity bitmap is too small for the column");
+  }
+  FormatRange(reinterpret_cast<const Uuid*>(values.data()), validity, 0, length, out.data());
+}
+
+}
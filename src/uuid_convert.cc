@@ -0,0 +1,121 @@
+#include "vscuuid/uuid_convert.hh"
+#include "cpu_dispatch.hh"
+#include "time_layout.hh"
+
+#include <stdexcept>
+
+namespace vscuuid {
+
+namespace {
+
+void CheckOutputSize(std::size_t in_size, std::size_t out_size) {
+  if (out_size < in_size) {
+    throw std::invalid_argument("Output span is smaller than the input span");
+  }
+}
+
+void CheckColumnSize(std::size_t column_size, std::size_t count) {
+  if (column_size != 0 && column_size < count) {
+    throw std::invalid_argument("Time field column is smaller than the input span");
+  }
+}
+
+}
+
+/**
+ * @brief Rewrites a version 1 UUID in the version 6 layout.
+ *
+ * RFC 9562 defines version 6 as version 1 with the timestamp stored most
+ * significant bits first, so the result sorts by creation time. The clock
+ * sequence, variant and node are kept, and ConvertV6ToV1() restores the
+ * original exactly. The conversion is a fixed sequence of shifts and masks; the
+ * input version is not checked, so callers mixing versions should filter on
+ * Uuid::version() first.
+ *
+ * @param uuid A version 1 UUID.
+ * @return The equivalent version 6 UUID.
+ */
+Uuid ConvertV1ToV6(const Uuid& uuid) noexcept {
+  Uuid result;
+  ConvertTimeLayoutScalar<true>(&uuid, 1, &result);
+  return result;
+}
+
+/**
+ * @brief Rewrites a version 6 UUID in the version 1 layout; the inverse of
+ * ConvertV1ToV6().
+ *
+ * @param uuid A version 6 UUID.
+ * @return The equivalent version 1 UUID.
+ */
+Uuid ConvertV6ToV1(const Uuid& uuid) noexcept {
+  Uuid result;
+  ConvertTimeLayoutScalar<false>(&uuid, 1, &result);
+  return result;
+}
+
+/**
+ * @brief Converts a span of version 1 UUIDs to version 6 with the widest
+ * available SIMD kernel.
+ *
+ * @param in The UUIDs to convert.
+ * @param out Receives in.size() results; may be the same memory as in.
+ * @throws std::invalid_argument if out is smaller than in.
+ */
+void ConvertV1ToV6(std::span<const Uuid> in, std::span<Uuid> out) {
+  CheckOutputSize(in.size(), out.size());
+  kernels::Active().convert_v1_to_v6(in.data(), in.size(), out.data());
+}
+
+/**
+ * @brief Converts a span of version 6 UUIDs to version 1 with the widest
+ * available SIMD kernel.
+ *
+ * @param in The UUIDs to convert.
+ * @param out Receives in.size() results; may be the same memory as in.
+ * @throws std::invalid_argument if out is smaller than in.
+ */
+void ConvertV6ToV1(std::span<const Uuid> in, std::span<Uuid> out) {
+  CheckOutputSize(in.size(), out.size());
+  kernels::Active().convert_v6_to_v1(in.data(), in.size(), out.data());
+}
+
+/**
+ * @brief Splits time-based UUIDs into timestamp, clock sequence and node columns.
+ *
+ * Timestamps are 60-bit counts of 100 ns intervals since 1582-10-15, decoded
+ * from the version 1 or version 6 layout as each UUID's version nibble
+ * requires; any other version yields timestamp 0. The layout is selected with
+ * masks rather than branches so mixed inputs do not cost mispredictions.
+ *
+ * @param uuids The UUIDs to decode.
+ * @param out The destination columns.
+ * @throws std::invalid_argument if a non-empty column is too small.
+ */
+void ExtractTimeFields(std::span<const Uuid> uuids, const TimeFieldColumns& out) {
+  CheckColumnSize(out.timestamps.size(), uuids.size());
+  CheckColumnSize(out.clock_sequences.size(), uuids.size());
+  CheckColumnSize(out.nodes.size(), uuids.size());
+  const bool want_timestamps = !out.timestamps.empty();
+  const bool want_clock_sequences = !out.clock_sequences.empty();
+  const bool want_nodes = !out.nodes.empty();
+  for (std::size_t i = 0; i < uuids.size(); ++i) {
+    const uint8_t* bytes = uuids[i].bytes().data();
+    uint64_t high = LoadBigEndian64(bytes);
+    uint64_t low = LoadBigEndian64(bytes + 8);
+    if (want_timestamps) {
+      uint64_t version = (high >> 12) & 0xF;
+      uint64_t v1_mask = uint64_t{0} - (version == 1);
+      uint64_t v6_mask = uint64_t{0} - (version == 6);
+      out.timestamps[i] = (V1HighToTimestamp(high) & v1_mask) | (V6HighToTimestamp(high) & v6_mask);
+    }
+    if (want_clock_sequences) {
+      out.clock_sequences[i] = static_cast<uint16_t>((low >> 48) & 0x3FFF);
+    }
+    if (want_nodes) {
+      out.nodes[i] = low & 0xFFFFFFFFFFFFULL;
+    }
+  }
+}
+
+}
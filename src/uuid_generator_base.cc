@@ -1,8 +1,6 @@
 #include "vscuuid/uuid_generator_base.hh"
+#include "vscuuid/entropy_source.hh"
 
-#include <iomanip>
-#include <sstream>
-#include <random>
 #include <stdexcept>
 
 namespace vscuuid {
@@ -19,17 +17,14 @@ UuidGeneratorBase::UuidGeneratorBase()
 /**
  * @brief Generates a unique node ID.
  *
- * This function generates a unique 48-bit node ID using a random number generator.
- * It uses a random device to seed a Mersenne Twister 64-bit engine and generates
- * a uniformly distributed random number in the range [0, 0xFFFFFFFFFFFF].
+ * This function generates a random 48-bit node ID from the thread's
+ * EntropySource, which is reseeded after fork() so that child processes never
+ * repeat the node IDs of their parent or siblings.
  *
  * @return A 48-bit unique node ID.
  */
 uint64_t UuidGeneratorBase::GenerateNodeId() {
-  static std::random_device rd;
-  static std::mt19937_64 gen(rd());
-  static std::uniform_int_distribution<uint64_t> dist(0, 0xFFFFFFFFFFFF);
-  return dist(gen);
+  return EntropySource::Next64() & 0xFFFFFFFFFFFF;
 }
 
 /**
@@ -46,6 +41,106 @@ uint16_t UuidGeneratorBase::GetClockSequence() {
   return clock_sequence_manager_->GetClockSequence();
 }
 
+/**
+ * @brief Selects where the generator keeps its clock sequence.
+ *
+ * Random bits come from the EntropySource, whose backend is chosen
+ * process-wide with EntropySource::Configure().
+ *
+ * @param backend StateBackend::kPerCpu to shard the clock sequence by CPU.
+ */
+void UuidGeneratorBase::SetStateBackend(StateBackend backend) {
+  clock_sequence_manager_ = std::make_shared<ClockSequenceManager>(backend);
+}
+
+/**
+ * @brief Formats the generator's next UUID into a standard string representation.
+ *
+ * @return A string representing the generated UUID.
+ */
+std::string UuidGeneratorBase::Generate() {
+  return GenerateUuid().ToString();
+}
+
+/**
+ * @brief Fills a span with freshly generated UUIDs.
+ *
+ * The default implementation calls GenerateUuid() once per element; generators
+ * that can amortize work across a batch override it.
+ *
+ * @param out The destination span.
+ */
+void UuidGeneratorBase::GenerateUuids(std::span<Uuid> out) {
+  for (auto& uuid : out) {
+    uuid = GenerateUuid();
+  }
+}
+
+/**
+ * @brief Returns an infinite, lazily evaluated range of UUIDs.
+ *
+ * UUIDs are produced on demand in batches of batch_size through
+ * GenerateUuids(), so the range composes with standard views such as
+ * std::views::take while keeping the per-element cost of the batch API. The
+ * generator must outlive the returned range.
+ *
+ * @param batch_size Number of UUIDs generated per refill.
+ * @return A view over the generator's output.
+ */
+UuidStream UuidGeneratorBase::Stream(std::size_t batch_size) {
+  return UuidStream(this, batch_size);
+}
+
+/**
+ * @brief Formats the generator's next UUID into a caller-supplied buffer.
+ *
+ * Unlike Generate(), this never touches the heap, which matters when
+ * producing millions of identifiers per second.
+ *
+ * @param out Destination for exactly 36 characters; no null terminator is written.
+ */
+void UuidGeneratorBase::GenerateTo(std::span<char, kUuidStringLength> out) {
+  GenerateUuid().FormatTo(out);
+}
+
+/**
+ * @brief Formats the generator's next UUID into a fixed-capacity inline string.
+ *
+ * @return A null-terminated UuidString.
+ */
+UuidString UuidGeneratorBase::GenerateString() {
+  return GenerateUuid().ToUuidString();
+}
+
+/**
+ * @brief Packs the given components of a UUID into its 16-byte binary form.
+ *
+ * @param time_low The low field of the timestamp.
+ * @param time_mid The middle field of the timestamp.
+ * @param time_hi_and_version The high field of the timestamp multiplexed with the version number.
+ * @param clock_seq The clock sequence.
+ * @param node The node field, typically representing the MAC address.
+ * @return The UUID in network byte order.
+ */
+Uuid UuidGeneratorBase::MakeUuid(uint64_t time_low, uint64_t time_mid,
+                                 uint64_t time_hi_and_version,
+                                 uint16_t clock_seq, uint64_t node) {
+  std::array<uint8_t, 16> bytes;
+  for (int i = 0; i < 4; ++i) {
+    bytes[i] = static_cast<uint8_t>(time_low >> (8 * (3 - i)));
+  }
+  bytes[4] = static_cast<uint8_t>(time_mid >> 8);
+  bytes[5] = static_cast<uint8_t>(time_mid);
+  bytes[6] = static_cast<uint8_t>(time_hi_and_version >> 8);
+  bytes[7] = static_cast<uint8_t>(time_hi_and_version);
+  bytes[8] = static_cast<uint8_t>(clock_seq >> 8);
+  bytes[9] = static_cast<uint8_t>(clock_seq);
+  for (int i = 0; i < 6; ++i) {
+    bytes[10 + i] = static_cast<uint8_t>(node >> (8 * (5 - i)));
+  }
+  return Uuid(bytes);
+}
+
 /**
  * @brief Formats the given components of a UUID into a standard string representation.
  *
@@ -63,14 +158,7 @@ uint16_t UuidGeneratorBase::GetClockSequence() {
 std::string UuidGeneratorBase::FormatUuid(uint64_t time_low, uint64_t time_mid,
                                           uint64_t time_hi_and_version,
                                           uint16_t clock_seq, uint64_t node) {
-  std::ostringstream oss;
-  oss << std::hex << std::setfill('0')
-      << std::setw(8) << time_low << "-"
-      << std::setw(4) << time_mid << "-"
-      << std::setw(4) << time_hi_and_version << "-"
-      << std::setw(4) << clock_seq << "-"
-      << std::setw(12) << (node & 0xFFFFFFFFFFFF);
-  return oss.str();
+  return MakeUuid(time_low, time_mid, time_hi_and_version, clock_seq, node).ToString();
 }
 
 }
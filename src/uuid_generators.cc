@@ -1,7 +1,6 @@
 #include "vscuuid/uuid_generators.hh"
-#include <random>
-#include <sstream>
-#include <iomanip>
+#include "vscuuid/entropy_source.hh"
+#include <algorithm>
 #include <chrono>
 #include <openssl/evp.h>
 #include <stdexcept>
@@ -14,9 +13,9 @@ namespace vscuuid {
  * This function generates a UUID (Universally Unique Identifier) version 1,
  * which is based on the current time and the node identifier.
  * 
- * @return A string representing the generated UUID.
+ * @return The generated UUID.
  */
-std::string UuidV1Generator::Generate() {
+Uuid UuidV1Generator::GenerateUuid() {
   auto now = std::chrono::system_clock::now();
   auto duration = now.time_since_epoch();
   uint64_t gregorian_offset = 122192928000000000ULL;
@@ -31,7 +30,7 @@ std::string UuidV1Generator::Generate() {
   uint16_t clock_seq = GetClockSequence() | 0x8000;
   uint64_t node = GenerateNodeId();
 
-  return FormatUuid(time_low, time_mid, time_hi_and_version, clock_seq, node);
+  return MakeUuid(time_low, time_mid, time_hi_and_version, clock_seq, node);
 }
 
 
@@ -47,11 +46,11 @@ UuidV2Generator::UuidV2Generator() : clock_sequence_manager_(std::make_shared<Cl
  * @brief Generates a UUID version 2.
  * 
  * This function generates a UUID (Universally Unique Identifier) version 2 based on the current system time,
- * clock sequence, and node identifier. The UUID is formatted according to the DCE 1.1 variant.
+ * clock sequence, and node identifier. The UUID is laid out according to the DCE 1.1 variant.
  * 
- * @return A string representing the generated UUID.
+ * @return The generated UUID.
  */
-std::string UuidV2Generator::Generate() {
+Uuid UuidV2Generator::GenerateUuid() {
     auto now = std::chrono::system_clock::now();
     auto duration = now.time_since_epoch();
     uint64_t gregorian_offset = 122192928000000000ULL;
@@ -67,24 +66,28 @@ std::string UuidV2Generator::Generate() {
 
     uint64_t node = GenerateNodeId();
 
-    return FormatUuid(time_low, time_mid, time_hi_and_version, clock_seq, node);
+    return MakeUuid(time_low, time_mid, time_hi_and_version, clock_seq, node);
+}
+
+/**
+ * @brief Selects where the generator keeps its clock sequence.
+ *
+ * @param backend StateBackend::kPerCpu to shard the clock sequence by CPU.
+ */
+void UuidV2Generator::SetStateBackend(StateBackend backend) {
+    clock_sequence_manager_ = std::make_shared<ClockSequenceManager>(backend);
 }
 
 /**
  * @brief Generates a unique node identifier.
  *
- * This function generates a unique 48-bit node identifier using a random
- * number generator. It utilizes a random device to seed a Mersenne Twister
- * 64-bit engine and produces a uniformly distributed random number in the
- * range [0, 0xFFFFFFFFFFFF].
+ * This function generates a random 48-bit node identifier from the thread's
+ * EntropySource, which is reseeded after fork().
  *
  * @return A 48-bit unique node identifier.
  */
 uint64_t UuidV2Generator::GenerateNodeId() {
-    static std::random_device rd;
-    static std::mt19937_64 gen(rd());
-    static std::uniform_int_distribution<uint64_t> dis(0, 0xFFFFFFFFFFFF);
-    return dis(gen);
+    return EntropySource::Next64() & 0xFFFFFFFFFFFF;
 }
 
 /**
@@ -99,18 +102,21 @@ UuidV3Generator::UuidV3Generator() {}
  *
  * This function generates a UUID version 3 based on the provided namespace UUID
  * and name. It uses the MD5 hashing algorithm to create a hash of the combined
- * namespace UUID and name, and then formats the hash into a UUID version 3.
+ * namespace UUID and name, and then packs the hash into a UUID version 3.
+ * With a cache set through SetCache(), repeated names skip the hash.
  *
  * @param namespace_uuid The namespace UUID as a string view.
  * @param name The name as a string view.
- * @return A string representing the generated UUID version 3.
+ * @return The generated UUID version 3.
  *
  * @throws std::runtime_error If there is an error creating the MD5 context or
  *                            computing the MD5 hash.
  */
-std::string UuidV3Generator::Generate(std::string_view namespace_uuid, std::string_view name) {
-    std::string input = std::string(namespace_uuid) + std::string(name);
-
+Uuid UuidV3Generator::GenerateUuid(std::string_view namespace_uuid, std::string_view name) {
+    Uuid cached;
+    if (cache_ && cache_->Lookup(3, namespace_uuid, name, &cached)) {
+        return cached;
+    }
     unsigned char hash[EVP_MAX_MD_SIZE];
     unsigned int hash_len;
     EVP_MD_CTX* mdctx = EVP_MD_CTX_new();
@@ -118,29 +124,58 @@ std::string UuidV3Generator::Generate(std::string_view namespace_uuid, std::stri
         throw std::runtime_error("Failed to create EVP_MD_CTX");
     }
     if (EVP_DigestInit_ex(mdctx, EVP_md5(), nullptr) != 1 ||
-        EVP_DigestUpdate(mdctx, input.c_str(), input.size()) != 1 ||
+        EVP_DigestUpdate(mdctx, namespace_uuid.data(), namespace_uuid.size()) != 1 ||
+        EVP_DigestUpdate(mdctx, name.data(), name.size()) != 1 ||
         EVP_DigestFinal_ex(mdctx, hash, &hash_len) != 1) {
         EVP_MD_CTX_free(mdctx);
         throw std::runtime_error("Failed to compute MD5 hash");
     }
     EVP_MD_CTX_free(mdctx);
 
-    uint32_t time_low = (hash[0] << 24) | (hash[1] << 16) | (hash[2] << 8) | hash[3];
-    uint16_t time_mid = (hash[4] << 8) | hash[5];
-    uint16_t time_hi_and_version = (hash[6] << 8) | hash[7];
-    time_hi_and_version &= 0x0FFF;
-    time_hi_and_version |= (3 << 12);
+    std::array<uint8_t, 16> bytes;
+    std::copy(hash, hash + 16, bytes.begin());
+    bytes[6] = (bytes[6] & 0x0F) | (3 << 4);
+    bytes[8] = (bytes[8] & 0x3F) | 0x80;
+    Uuid uuid(bytes);
+    if (cache_) {
+        cache_->Insert(3, namespace_uuid, name, uuid);
+    }
+    return uuid;
+}
 
-    uint16_t clock_seq = (hash[8] << 8) | hash[9];
-    clock_seq &= 0x3FFF;
-    clock_seq |= 0x8000;
+/**
+ * @brief Puts a cache in front of the MD5 computation.
+ *
+ * The cache may be shared with other V3 and V5 generators; entries are keyed
+ * by version as well as namespace and name.
+ *
+ * @param cache The cache to consult, or nullptr to always hash.
+ */
+void UuidV3Generator::SetCache(std::shared_ptr<NameUuidCache> cache) {
+    cache_ = std::move(cache);
+}
 
-    uint64_t node = 0;
-    for (int i = 0; i < 6; ++i) {
-        node |= static_cast<uint64_t>(hash[10 + i]) << (8 * (5 - i));
-    }
+/**
+ * @brief Generates a UUID version 3 and formats it as a string.
+ *
+ * @param namespace_uuid The namespace UUID as a string view.
+ * @param name The name as a string view.
+ * @return A string representing the generated UUID version 3.
+ */
+std::string UuidV3Generator::Generate(std::string_view namespace_uuid, std::string_view name) {
+    return GenerateUuid(namespace_uuid, name).ToString();
+}
 
-    return FormatUuid(time_low, time_mid, time_hi_and_version, clock_seq, node);
+/**
+ * @brief Generates a UUID version 3 into a caller-supplied buffer without allocating.
+ *
+ * @param namespace_uuid The namespace UUID as a string view.
+ * @param name The name as a string view.
+ * @param out Destination for exactly 36 characters.
+ */
+void UuidV3Generator::GenerateTo(std::string_view namespace_uuid, std::string_view name,
+                                 std::span<char, kUuidStringLength> out) {
+    GenerateUuid(namespace_uuid, name).FormatTo(out);
 }
 
 /**
@@ -149,12 +184,10 @@ std::string UuidV3Generator::Generate(std::string_view namespace_uuid, std::stri
  * This function generates a UUID version 3 using a predefined namespace UUID 
  * ("6ba7b810-9dad-11d1-80b4-00c04fd430c8") and a default name ("default").
  * 
- * @return std::string The generated UUID version 3 as a string.
+ * @return The generated UUID version 3.
  */
-std::string UuidV3Generator::Generate() {
-    std::string namespace_uuid = "6ba7b810-9dad-11d1-80b4-00c04fd430c8";
-    std::string name = "default";
-    return Generate(namespace_uuid, name);
+Uuid UuidV3Generator::GenerateUuid() {
+    return GenerateUuid("6ba7b810-9dad-11d1-80b4-00c04fd430c8", "default");
 }
 
 /**
@@ -165,38 +198,41 @@ std::string UuidV3Generator::Generate() {
 UuidV4Generator::UuidV4Generator() {}
 
 /**
- * @brief Generates a UUID version 4 string.
+ * @brief Generates a UUID version 4.
  * 
  * This function generates a random UUID (Universally Unique Identifier) 
- * version 4, which is based on random numbers.
+ * version 4, which is based on random numbers drawn from the EntropySource.
  * 
- * @return std::string A string representation of the generated UUID v4.
+ * @return The generated UUID v4.
  * 
- * The format of the UUID v4 string is:
+ * The text form of a UUID v4 is:
  * xxxxxxxx-xxxx-4xxx-yxxx-xxxxxxxxxxxx
  * where 'x' is any hexadecimal digit and 'y' is one of 8, 9, A, or B.
  */
-std::string UuidV4Generator::Generate() {
-    std::random_device rd;
-    std::mt19937_64 gen(rd());
-    std::uniform_int_distribution<uint64_t> dis;
-
-    uint32_t time_low = dis(gen) & 0xFFFFFFFF;
-    uint16_t time_mid = dis(gen) & 0xFFFF;
-    uint16_t time_hi_and_version = (dis(gen) & 0x0FFF) | (4 << 12);
-
-    uint16_t clock_seq = (dis(gen) & 0x3FFF) | 0x8000;
-
-    uint64_t node = dis(gen) & 0xFFFFFFFFFFFF;
-
-    std::ostringstream oss;
-    oss << std::hex << std::setfill('0')
-        << std::setw(8) << time_low << "-"
-        << std::setw(4) << time_mid << "-"
-        << std::setw(4) << time_hi_and_version << "-"
-        << std::setw(4) << clock_seq << "-"
-        << std::setw(12) << node;
-    return oss.str();
+Uuid UuidV4Generator::GenerateUuid() {
+    std::array<uint8_t, 16> bytes;
+    EntropySource::Fill(bytes);
+    bytes[6] = (bytes[6] & 0x0F) | (4 << 4);
+    bytes[8] = (bytes[8] & 0x3F) | 0x80;
+    return Uuid(bytes);
+}
+
+/**
+ * @brief Generates a batch of UUID version 4 values.
+ *
+ * The random bits for the whole batch are drawn from the EntropySource in one
+ * call, then the version and variant bits are stamped onto each UUID.
+ *
+ * @param out The destination span.
+ */
+void UuidV4Generator::GenerateUuids(std::span<Uuid> out) {
+    static_assert(sizeof(Uuid) == 16, "Uuid must be exactly 16 bytes");
+    EntropySource::Fill(std::span<uint8_t>(reinterpret_cast<uint8_t*>(out.data()), out.size_bytes()));
+    for (auto& uuid : out) {
+        auto& bytes = uuid.bytes();
+        bytes[6] = (bytes[6] & 0x0F) | (4 << 4);
+        bytes[8] = (bytes[8] & 0x3F) | 0x80;
+    }
 }
 
 /**
@@ -212,16 +248,19 @@ UuidV5Generator::UuidV5Generator() {}
  * This function generates a UUID version 5 by computing the SHA-1 hash of the
  * concatenation of the namespace UUID and the name. The resulting hash is then
  * used to construct the UUID according to the UUID version 5 specification.
+ * With a cache set through SetCache(), repeated names skip the hash.
  *
  * @param namespace_uuid The namespace UUID as a string view.
  * @param name The name as a string view.
- * @return A string representing the generated UUID version 5.
+ * @return The generated UUID version 5.
  *
  * @throws std::runtime_error If there is an error during the SHA-1 hash computation.
  */
-std::string UuidV5Generator::Generate(std::string_view namespace_uuid, std::string_view name) {
-    std::string input = std::string(namespace_uuid) + std::string(name);
-
+Uuid UuidV5Generator::GenerateUuid(std::string_view namespace_uuid, std::string_view name) {
+    Uuid cached;
+    if (cache_ && cache_->Lookup(5, namespace_uuid, name, &cached)) {
+        return cached;
+    }
     unsigned char hash[EVP_MAX_MD_SIZE];
     unsigned int hash_len;
     EVP_MD_CTX* mdctx = EVP_MD_CTX_new();
@@ -229,29 +268,58 @@ std::string UuidV5Generator::Generate(std::string_view namespace_uuid, std::stri
         throw std::runtime_error("Failed to create EVP_MD_CTX");
     }
     if (EVP_DigestInit_ex(mdctx, EVP_sha1(), nullptr) != 1 ||
-        EVP_DigestUpdate(mdctx, input.c_str(), input.size()) != 1 ||
+        EVP_DigestUpdate(mdctx, namespace_uuid.data(), namespace_uuid.size()) != 1 ||
+        EVP_DigestUpdate(mdctx, name.data(), name.size()) != 1 ||
         EVP_DigestFinal_ex(mdctx, hash, &hash_len) != 1) {
         EVP_MD_CTX_free(mdctx);
         throw std::runtime_error("Failed to compute SHA-1 hash");
     }
     EVP_MD_CTX_free(mdctx);
 
-    uint32_t time_low = (hash[0] << 24) | (hash[1] << 16) | (hash[2] << 8) | hash[3];
-    uint16_t time_mid = (hash[4] << 8) | hash[5];
-    uint16_t time_hi_and_version = (hash[6] << 8) | hash[7];
-    time_hi_and_version &= 0x0FFF;
-    time_hi_and_version |= (5 << 12);
+    std::array<uint8_t, 16> bytes;
+    std::copy(hash, hash + 16, bytes.begin());
+    bytes[6] = (bytes[6] & 0x0F) | (5 << 4);
+    bytes[8] = (bytes[8] & 0x3F) | 0x80;
+    Uuid uuid(bytes);
+    if (cache_) {
+        cache_->Insert(5, namespace_uuid, name, uuid);
+    }
+    return uuid;
+}
 
-    uint16_t clock_seq = (hash[8] << 8) | hash[9];
-    clock_seq &= 0x3FFF;
-    clock_seq |= 0x8000;
+/**
+ * @brief Puts a cache in front of the SHA-1 computation.
+ *
+ * The cache may be shared with other V3 and V5 generators; entries are keyed
+ * by version as well as namespace and name.
+ *
+ * @param cache The cache to consult, or nullptr to always hash.
+ */
+void UuidV5Generator::SetCache(std::shared_ptr<NameUuidCache> cache) {
+    cache_ = std::move(cache);
+}
 
-    uint64_t node = 0;
-    for (int i = 0; i < 6; ++i) {
-        node |= static_cast<uint64_t>(hash[10 + i]) << (8 * (5 - i));
-    }
+/**
+ * @brief Generates a UUID version 5 and formats it as a string.
+ *
+ * @param namespace_uuid The namespace UUID as a string view.
+ * @param name The name as a string view.
+ * @return A string representing the generated UUID version 5.
+ */
+std::string UuidV5Generator::Generate(std::string_view namespace_uuid, std::string_view name) {
+    return GenerateUuid(namespace_uuid, name).ToString();
+}
 
-    return FormatUuid(time_low, time_mid, time_hi_and_version, clock_seq, node);
+/**
+ * @brief Generates a UUID version 5 into a caller-supplied buffer without allocating.
+ *
+ * @param namespace_uuid The namespace UUID as a string view.
+ * @param name The name as a string view.
+ * @param out Destination for exactly 36 characters.
+ */
+void UuidV5Generator::GenerateTo(std::string_view namespace_uuid, std::string_view name,
+                                 std::span<char, kUuidStringLength> out) {
+    GenerateUuid(namespace_uuid, name).FormatTo(out);
 }
 
 /**
@@ -260,12 +328,10 @@ std::string UuidV5Generator::Generate(std::string_view namespace_uuid, std::stri
  * This function generates a UUID version 5 (SHA-1 hash based) using a predefined
  * namespace UUID ("6ba7b810-9dad-11d1-80b4-00c04fd430c8") and a default name ("default").
  * 
- * @return A string representing the generated UUID version 5.
+ * @return The generated UUID version 5.
  */
-std::string UuidV5Generator::Generate() {
-    std::string namespace_uuid = "6ba7b810-9dad-11d1-80b4-00c04fd430c8";
-    std::string name = "default";
-    return Generate(namespace_uuid, name);
+Uuid UuidV5Generator::GenerateUuid() {
+    return GenerateUuid("6ba7b810-9dad-11d1-80b4-00c04fd430c8", "default");
 }
 
 /**
@@ -279,26 +345,28 @@ UuidV6Generator::UuidV6Generator() {}
  * @brief Generates a UUID version 6.
  * 
  * This function generates a UUID (Universally Unique Identifier) version 6 based on the current system time.
- * It uses the current time since epoch, adds the Gregorian offset, and formats the timestamp according to the UUID version 6 specification.
+ * It uses the current time since epoch, adds the Gregorian offset, and lays out the timestamp according to the UUID version 6 specification
+ * (RFC 9562): the version 1 fields in reverse order, most significant bits first.
  * 
- * @return A string representing the generated UUID version 6.
+ * @return The generated UUID version 6.
  */
-std::string UuidV6Generator::Generate() {
+Uuid UuidV6Generator::GenerateUuid() {
     auto now = std::chrono::system_clock::now();
     auto duration = now.time_since_epoch();
     uint64_t gregorian_offset = 122192928000000000ULL;
     uint64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / 100 + gregorian_offset;
 
-    uint64_t time_low = timestamp & 0xFFFFFFFF;
-    uint64_t time_mid = (timestamp >> 32) & 0xFFFF;
-    uint64_t time_hi_and_version = (timestamp >> 48) & 0x0FFF;
-    time_hi_and_version |= (6 << 12); // Version 6
+    // Most significant bits first, so that UUIDs sort by creation time.
+    uint64_t time_high = (timestamp >> 28) & 0xFFFFFFFF;
+    uint64_t time_mid = (timestamp >> 12) & 0xFFFF;
+    uint64_t time_low_and_version = timestamp & 0x0FFF;
+    time_low_and_version |= (6 << 12); // Version 6
 
     uint16_t clock_seq = GetClockSequence() | 0x8000;
 
     uint64_t node = GenerateNodeId();
 
-    return FormatUuid(time_low, time_mid, time_hi_and_version, clock_seq, node);
+    return MakeUuid(time_high, time_mid, time_low_and_version, clock_seq, node);
 }
 
 /**
@@ -309,108 +377,125 @@ std::string UuidV6Generator::Generate() {
 UuidV7Generator::UuidV7Generator() {}
 
 /**
- * @brief Generates a UUID version 7 string.
+ * @brief Generates a UUID version 7.
  * 
  * This function generates a UUID (Universally Unique Identifier) version 7
- * string based on the current system time and random values. The UUID format
+ * based on the current system time and random values. The UUID text form
  * is as follows:
  * 
  *     xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx
  * 
  * where each 'x' is a hexadecimal digit.
  * 
- * @return std::string The generated UUID version 7 string.
+ * In monotonic mode the 14 bits after the variant hold a counter that
+ * restarts from a random value every millisecond, so UUIDs from one generator
+ * sort in generation order even within a millisecond or if the clock steps
+ * back.
+ *
+ * @return The generated UUID version 7.
  */
-std::string UuidV7Generator::Generate() {
+Uuid UuidV7Generator::GenerateUuid() {
     auto now = std::chrono::system_clock::now();
     auto duration = now.time_since_epoch();
     uint64_t timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
 
+    uint64_t random = EntropySource::Next64();
+    uint16_t clock_seq = random & 0x3FFF;
+
+    if (monotonic_.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (timestamp > last_timestamp_) {
+            // Start each millisecond in the lower half so it can count up.
+            last_timestamp_ = timestamp;
+            counter_ = clock_seq & 0x1FFF;
+        } else if (++counter_ > 0x3FFF) {
+            // Counter exhausted: borrow the next millisecond.
+            ++last_timestamp_;
+            counter_ = clock_seq & 0x1FFF;
+        }
+        timestamp = last_timestamp_;
+        clock_seq = counter_;
+    }
+
     uint64_t time_high = (timestamp >> 28) & 0xFFFFFFFF;
     uint64_t time_mid = (timestamp >> 12) & 0xFFFF;
     uint64_t time_low_and_version = (timestamp & 0xFFF) | (7 << 12);
 
-    std::random_device rd;
-    std::mt19937_64 gen(rd());
-    std::uniform_int_distribution<uint64_t> dis;
-
-    uint16_t clock_seq = dis(gen) & 0x3FFF;
     clock_seq |= 0x8000;
 
-    uint64_t node = dis(gen) & 0xFFFFFFFFFFFF;
+    uint64_t node = (random >> 16) & 0xFFFFFFFFFFFF;
 
-    std::ostringstream oss;
-    oss << std::hex << std::setfill('0')
-        << std::setw(8) << time_high << "-"
-        << std::setw(4) << time_mid << "-"
-        << std::setw(4) << time_low_and_version << "-"
-        << std::setw(4) << clock_seq << "-"
-        << std::setw(12) << node;
-    return oss.str();
+    return MakeUuid(time_high, time_mid, time_low_and_version, clock_seq, node);
 }
 
 
+/**
+ * @brief Enables or disables the per-millisecond counter.
+ *
+ * @param monotonic true to make successive UUIDs strictly increasing.
+ */
+void UuidV7Generator::SetMonotonic(bool monotonic) {
+    monotonic_.store(monotonic, std::memory_order_relaxed);
+}
+
 /**
  * @brief Default constructor for the UuidV8Generator class.
  */
 UuidV8Generator::UuidV8Generator() {}
 
+/**
+ * @brief Generates a UUID version 8 from the given custom data.
+ *
+ * This function takes a 16-byte array of custom data and stamps the version
+ * and variant bits onto it; all other bits are taken verbatim.
+ *
+ * @param custom_data A 16-byte array containing the custom data used to generate the UUID.
+ * @return The generated UUID version 8.
+ */
+Uuid UuidV8Generator::GenerateUuid(const std::array<uint8_t, 16>& custom_data) {
+    std::array<uint8_t, 16> bytes = custom_data;
+    bytes[6] = (bytes[6] & 0x0F) | (8 << 4);
+    bytes[8] = (bytes[8] & 0x3F) | 0x80;
+    return Uuid(bytes);
+}
+
 /**
  * @brief Generates a UUID version 8 string from the given custom data.
  *
- * This function takes a 16-byte array of custom data and generates a UUID version 8 string.
  * The UUID is formatted as a string in the standard 8-4-4-4-12 hexadecimal format.
  *
  * @param custom_data A 16-byte array containing the custom data used to generate the UUID.
  * @return A string representing the generated UUID version 8.
  */
 std::string UuidV8Generator::Generate(const std::array<uint8_t, 16>& custom_data) {
-    uint32_t time_low = (custom_data[0] << 24) | (custom_data[1] << 16) | (custom_data[2] << 8) | custom_data[3];
-    uint16_t time_mid = (custom_data[4] << 8) | custom_data[5];
-    uint16_t time_hi_and_version = (custom_data[6] << 8) | custom_data[7];
-    time_hi_and_version &= 0x0FFF;
-    time_hi_and_version |= (8 << 12);
-
-    uint16_t clock_seq = (custom_data[8] << 8) | custom_data[9];
-    clock_seq &= 0x3FFF;
-    clock_seq |= 0x8000;
-
-    uint64_t node = 0;
-    for (int i = 0; i < 6; ++i) {
-        node |= static_cast<uint64_t>(custom_data[10 + i]) << (8 * (5 - i));
-    }
+    return GenerateUuid(custom_data).ToString();
+}
 
-    std::ostringstream oss;
-    oss << std::hex << std::setfill('0')
-        << std::setw(8) << time_low << "-"
-        << std::setw(4) << time_mid << "-"
-        << std::setw(4) << time_hi_and_version << "-"
-        << std::setw(4) << clock_seq << "-"
-        << std::setw(12) << node;
-    return oss.str();
+/**
+ * @brief Generates a UUID version 8 from custom data into a caller-supplied buffer.
+ *
+ * @param custom_data A 16-byte array containing the custom data used to generate the UUID.
+ * @param out Destination for exactly 36 characters.
+ */
+void UuidV8Generator::GenerateTo(const std::array<uint8_t, 16>& custom_data,
+                                 std::span<char, kUuidStringLength> out) {
+    GenerateUuid(custom_data).FormatTo(out);
 }
 
 /**
- * @brief Generates a UUID version 8 string.
+ * @brief Generates a UUID version 8.
  *
- * This function generates a UUID version 8 by creating a random 128-bit value
- * using a random device and a Mersenne Twister 64-bit generator. The random
- * value is then passed to another Generate function that converts it into a
- * UUID string.
+ * This function generates a UUID version 8 by drawing a random 128-bit value
+ * from the EntropySource. The random value is then passed to the custom-data
+ * overload which stamps the version and variant bits.
  *
- * @return A string representing the generated UUID version 8.
+ * @return The generated UUID version 8.
  */
-std::string UuidV8Generator::Generate() {
-    std::random_device rd;
-    std::mt19937_64 gen(rd());
-    std::uniform_int_distribution<uint64_t> dis;
-
+Uuid UuidV8Generator::GenerateUuid() {
     std::array<uint8_t, 16> custom_data;
-    for (auto& byte : custom_data) {
-        byte = static_cast<uint8_t>(dis(gen) & 0xFF);
-    }
+    EntropySource::Fill(custom_data);
 
-    return Generate(custom_data);
+    return GenerateUuid(custom_data);
 }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,226 @@
+#include "vscuuid/uuid_index.hh"
+#include "mapped_file.hh"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define VSCUUID_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define VSCUUID_PREFETCH(address) ((void)(address))
+#endif
+
+namespace vscuuid {
+
+namespace {
+
+constexpr char kIndexMagic[8] = {'V', 'S', 'C', 'U', 'I', 'D', 'X', '1'};
+constexpr std::size_t kHeaderSize = 64;
+constexpr std::size_t kBatchGroup = 16;
+
+struct Key {
+  uint64_t hi;
+  uint64_t lo;
+};
+
+inline uint64_t LoadBigEndian64(const uint8_t* bytes) {
+  uint64_t value;
+  std::memcpy(&value, bytes, sizeof(value));
+  if constexpr (std::endian::native == std::endian::little) {
+    value = std::byteswap(value);
+  }
+  return value;
+}
+
+inline Key LoadKey(const Uuid& uuid) {
+  return Key{LoadBigEndian64(uuid.bytes().data()), LoadBigEndian64(uuid.bytes().data() + 8)};
+}
+
+inline std::size_t Less(const Key& a, const Key& b) {
+  return (a.hi < b.hi) | ((a.hi == b.hi) & (a.lo < b.lo));
+}
+
+// One branch-free descent step; also prefetches the cache line holding the
+// four grandchildren of k, which is 64-byte aligned because slot 0 is.
+inline std::size_t Descend(const Uuid* slots, std::size_t k, const Key& key) {
+  VSCUUID_PREFETCH(slots + 4 * k);
+  return 2 * k + Less(LoadKey(slots[k]), key);
+}
+
+// Maps the slot reached after falling off the tree back to its lower bound.
+inline std::size_t Resolve(std::size_t k) {
+  return k >> (std::countr_one(k) + 1);
+}
+
+void PlaceInOrder(const std::vector<Uuid>& sorted, Uuid* slots, std::size_t size,
+                  std::size_t k, std::size_t* next) {
+  if (k > size) {
+    return;
+  }
+  PlaceInOrder(sorted, slots, size, 2 * k, next);
+  slots[k] = sorted[(*next)++];
+  PlaceInOrder(sorted, slots, size, 2 * k + 1, next);
+}
+
+}
+
+/**
+ * @brief Builds an immutable membership index from a set of UUIDs.
+ *
+ * The UUIDs are sorted, deduplicated and laid out in Eytzinger (breadth-first)
+ * order in a 64-byte aligned array. A lookup then walks an implicit binary tree
+ * whose top levels stay hot in cache and whose next levels can be prefetched,
+ * instead of jumping across a sorted array as binary search does.
+ *
+ * @param uuids The members of the set; duplicates are allowed.
+ * @return The index.
+ */
+UuidIndex UuidIndex::Build(std::span<const Uuid> uuids) {
+  std::vector<Uuid> sorted(uuids.begin(), uuids.end());
+  std::sort(sorted.begin(), sorted.end());
+  sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+  const std::size_t size = sorted.size();
+  void* raw = ::operator new(sizeof(Uuid) * (size + 1), std::align_val_t{64});
+  Uuid* slots = static_cast<Uuid*>(raw);
+  std::uninitialized_value_construct_n(slots, size + 1);
+  std::shared_ptr<const void> storage(raw, [](const void* p) {
+    ::operator delete(const_cast<void*>(p), std::align_val_t{64});
+  });
+
+  std::size_t next = 0;
+  PlaceInOrder(sorted, slots, size, 1, &next);
+  return UuidIndex(std::move(storage), slots, size);
+}
+
+/**
+ * @brief Opens an index previously written by Save().
+ *
+ * The file is memory mapped and used in place, so opening is independent of
+ * the number of entries and pages are loaded on first use.
+ *
+ * @param path The index file.
+ * @return The index.
+ * @throws std::runtime_error if the file cannot be mapped or is not a valid index.
+ */
+UuidIndex UuidIndex::Open(const std::string& path) {
+  auto file = std::make_shared<MappedFile>(path);
+  if (file->size() < kHeaderSize || std::memcmp(file->data(), kIndexMagic, sizeof(kIndexMagic)) != 0) {
+    throw std::runtime_error("Invalid UUID index file: " + path);
+  }
+  uint64_t count = 0;
+  for (int i = 7; i >= 0; --i) {
+    count = (count << 8) | static_cast<uint8_t>(file->data()[8 + i]);
+  }
+  // Compare against the slot count rather than count + 1, which wraps for a
+  // corrupt count of UINT64_MAX.
+  const std::size_t slot_count = (file->size() - kHeaderSize) / sizeof(Uuid);
+  if (count >= slot_count || slot_count != count + 1 || (file->size() - kHeaderSize) % sizeof(Uuid) != 0) {
+    throw std::runtime_error("Truncated UUID index file: " + path);
+  }
+  const Uuid* slots = reinterpret_cast<const Uuid*>(file->data() + kHeaderSize);
+  return UuidIndex(std::shared_ptr<const void>(file, file.get()), slots, static_cast<std::size_t>(count));
+}
+
+/**
+ * @brief Writes the index to a file that Open() can map directly.
+ *
+ * The layout is a 64-byte header (magic and little-endian entry count)
+ * followed by the Eytzinger slots as raw 16-byte UUIDs, so the file is
+ * independent of the host byte order.
+ *
+ * @param path The destination file.
+ * @throws std::runtime_error if the file cannot be written.
+ */
+void UuidIndex::Save(const std::string& path) const {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("Failed to open file: " + path);
+  }
+  std::array<char, kHeaderSize> header{};
+  std::memcpy(header.data(), kIndexMagic, sizeof(kIndexMagic));
+  for (int i = 0; i < 8; ++i) {
+    header[8 + i] = static_cast<char>((static_cast<uint64_t>(size_) >> (8 * i)) & 0xFF);
+  }
+  out.write(header.data(), header.size());
+  const Uuid padding;
+  out.write(reinterpret_cast<const char*>(slots_ != nullptr ? slots_ : &padding),
+            static_cast<std::streamsize>(sizeof(Uuid) * (size_ + 1)));
+  if (!out) {
+    throw std::runtime_error("Failed to write file: " + path);
+  }
+}
+
+/**
+ * @brief Tests whether a UUID is a member of the set.
+ *
+ * @param uuid The UUID to look up.
+ * @return true if the UUID was part of the set the index was built from.
+ */
+bool UuidIndex::Contains(const Uuid& uuid) const {
+  if (size_ == 0) {
+    return false;
+  }
+  const Key key = LoadKey(uuid);
+  std::size_t k = 1;
+  while (k <= size_) {
+    k = Descend(slots_, k, key);
+  }
+  k = Resolve(k);
+  return k != 0 && slots_[k] == uuid;
+}
+
+/**
+ * @brief Tests a batch of UUIDs for membership.
+ *
+ * Queries are processed in groups that descend the tree in lockstep. Every
+ * level of the complete part of the tree is visited by every query, so the
+ * loop has no data-dependent branches and the memory accesses of one group
+ * overlap instead of being serialized cache miss after cache miss.
+ *
+ * @param queries The UUIDs to look up.
+ * @param results Receives one flag per query; must be at least as large as queries.
+ * @throws std::invalid_argument if results is smaller than queries.
+ */
+void UuidIndex::ContainsBatch(std::span<const Uuid> queries, std::span<bool> results) const {
+  if (results.size() < queries.size()) {
+    throw std::invalid_argument("Result span is smaller than the query span");
+  }
+  if (size_ == 0) {
+    std::fill_n(results.begin(), queries.size(), false);
+    return;
+  }
+  const int full_levels = std::bit_width(size_ + 1) - 1;
+  std::array<Key, kBatchGroup> keys;
+  std::array<std::size_t, kBatchGroup> slots;
+
+  for (std::size_t base = 0; base < queries.size(); base += kBatchGroup) {
+    const std::size_t group = std::min(kBatchGroup, queries.size() - base);
+    for (std::size_t g = 0; g < group; ++g) {
+      keys[g] = LoadKey(queries[base + g]);
+      slots[g] = 1;
+    }
+    for (int level = 0; level < full_levels; ++level) {
+      for (std::size_t g = 0; g < group; ++g) {
+        slots[g] = Descend(slots_, slots[g], keys[g]);
+      }
+    }
+    for (std::size_t g = 0; g < group; ++g) {
+      std::size_t k = slots[g];
+      if (k <= size_) {
+        k = Descend(slots_, k, keys[g]);
+      }
+      k = Resolve(k);
+      results[base + g] = k != 0 && slots_[k] == queries[base + g];
+    }
+  }
+}
+
+}
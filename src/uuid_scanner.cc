@@ -0,0 +1,93 @@
+#include "vscuuid/uuid_scanner.hh"
+#include "cpu_dispatch.hh"
+#include "mapped_file.hh"
+#include "ordered_pipeline.hh"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace vscuuid {
+
+namespace {
+
+constexpr std::size_t kBlockSize = std::size_t{1} << 20;
+constexpr std::size_t kChunkSize = std::size_t{4} << 20;
+
+}
+
+/**
+ * @brief Finds every UUID in a text buffer.
+ *
+ * Matches must be in the canonical 8-4-4-4-12 form (either letter case) and may
+ * not be directly preceded or followed by another hexadecimal digit. The
+ * callback receives matches in increasing offset order together with the
+ * parsed value. The buffer is processed in blocks so memory use is independent
+ * of the input size.
+ *
+ * @param haystack The text to search.
+ * @param callback Invoked once per match.
+ * @return The number of matches found.
+ */
+std::size_t ScanUuids(std::string_view haystack, const UuidMatchCallback& callback) {
+  kernels::ScanKernel kernel = kernels::Active().scan;
+  std::vector<UuidMatch> matches;
+  std::size_t count = 0;
+  for (std::size_t begin = 0; begin < haystack.size(); begin += kBlockSize) {
+    std::size_t end = std::min(haystack.size(), begin + kBlockSize);
+    matches.clear();
+    kernel(haystack.data(), haystack.size(), begin, end, &matches);
+    for (const auto& match : matches) {
+      callback(match);
+    }
+    count += matches.size();
+  }
+  return count;
+}
+
+/**
+ * @brief Finds every UUID in a file using several threads.
+ *
+ * The file is memory mapped and split into fixed-size chunks. Workers scan
+ * chunks independently; a UUID straddling a chunk boundary belongs to the chunk
+ * containing its first character, so nothing is lost or reported twice. Results
+ * are handed to the callback on the calling thread in file order, and at most
+ * two chunks per worker are in flight, which bounds memory use.
+ *
+ * @param path The file to scan.
+ * @param callback Invoked once per match, always from the calling thread.
+ * @param thread_count Number of worker threads; 0 selects the hardware concurrency.
+ * @return The number of matches found.
+ * @throws std::runtime_error if the file cannot be mapped.
+ */
+std::size_t ScanUuidsInFile(const std::string& path, const UuidMatchCallback& callback,
+                            unsigned thread_count) {
+  MappedFile file(path);
+  const std::size_t chunk_count = (file.size() + kChunkSize - 1) / kChunkSize;
+  if (thread_count == 0) {
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+  thread_count = static_cast<unsigned>(std::min<std::size_t>(thread_count, chunk_count));
+  if (thread_count <= 1) {
+    return ScanUuids(file.view(), callback);
+  }
+
+  kernels::ScanKernel kernel = kernels::Active().scan;
+  std::size_t count = 0;
+  RunOrderedPipeline<std::vector<UuidMatch>>(
+      chunk_count, thread_count, 2 * static_cast<std::size_t>(thread_count),
+      [&](std::size_t chunk, std::vector<UuidMatch>& matches) {
+        std::size_t begin = chunk * kChunkSize;
+        matches.clear();
+        kernel(file.data(), file.size(), begin, std::min(file.size(), begin + kChunkSize), &matches);
+      },
+      [&](const std::vector<UuidMatch>& matches) {
+        for (const auto& match : matches) {
+          callback(match);
+        }
+        count += matches.size();
+      });
+  return count;
+}
+
+}
@@ -0,0 +1,46 @@
+#include "vscuuid/uuid_stream.hh"
+#include "vscuuid/uuid_generator_base.hh"
+
+#include <stdexcept>
+
+namespace vscuuid {
+
+/**
+ * @brief Constructs a stream drawing from the given generator.
+ *
+ * No UUID is generated until the stream is first iterated.
+ *
+ * @param generator The generator backing the stream; it must outlive the stream.
+ * @param batch_size Number of UUIDs generated per refill.
+ * @throws std::invalid_argument if batch_size is zero.
+ */
+UuidStream::UuidStream(UuidGeneratorBase* generator, std::size_t batch_size)
+    : generator_(generator), buffer_(batch_size) {
+  if (batch_size == 0) {
+    throw std::invalid_argument("Stream batch size must be positive");
+  }
+}
+
+/**
+ * @brief Returns an iterator to the current position of the stream.
+ *
+ * Like any input range the stream is single-pass: iterating it again resumes
+ * where the previous iteration stopped.
+ */
+UuidStream::Iterator UuidStream::begin() {
+  if (!primed_) {
+    Refill();
+    primed_ = true;
+  }
+  return Iterator(this);
+}
+
+/**
+ * @brief Replaces the buffered batch with freshly generated UUIDs.
+ */
+void UuidStream::Refill() {
+  generator_->GenerateUuids(buffer_);
+  position_ = 0;
+}
+
+}
@@ -0,0 +1,207 @@
+#include "vscuuid/vscuuid_c.h"
+#include "vscuuid/uuid_factory.hh"
+#include "name_hasher.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+struct vscuuid_generator {
+  int version;
+  std::unique_ptr<vscuuid::UuidGeneratorBase> generator;
+};
+
+namespace {
+
+// Values are staged through a small stack buffer so caller memory is only
+// ever accessed as bytes, whatever its alignment.
+constexpr std::size_t kChunk = 256;
+
+// Runs body and maps any C++ exception onto a status code: nothing may
+// propagate across the C boundary.
+template <typename Body>
+vscuuid_status Guard(Body&& body) noexcept {
+  try {
+    return body();
+  } catch (const std::bad_alloc&) {
+    return VSCUUID_ERROR_OUT_OF_MEMORY;
+  } catch (const std::invalid_argument&) {
+    return VSCUUID_ERROR_INVALID_ARGUMENT;
+  } catch (...) {
+    return VSCUUID_ERROR_INTERNAL;
+  }
+}
+
+}
+
+extern "C" {
+
+/**
+ * @brief Returns VSCUUID_C_ABI_VERSION as compiled into the library.
+ *
+ * Callers compare it with the header they were built against.
+ */
+int vscuuid_abi_version(void) {
+  return VSCUUID_C_ABI_VERSION;
+}
+
+/**
+ * @brief Returns a static, human-readable description of a status code.
+ */
+const char* vscuuid_status_string(vscuuid_status status) {
+  switch (status) {
+    case VSCUUID_OK:
+      return "ok";
+    case VSCUUID_ERROR_INVALID_ARGUMENT:
+      return "invalid argument";
+    case VSCUUID_ERROR_BUFFER_TOO_SMALL:
+      return "buffer too small";
+    case VSCUUID_ERROR_PARSE:
+      return "malformed UUID";
+    case VSCUUID_ERROR_OUT_OF_MEMORY:
+      return "out of memory";
+    case VSCUUID_ERROR_INTERNAL:
+      return "internal error";
+  }
+  return "unknown status";
+}
+
+/**
+ * @brief Creates a generator handle.
+ *
+ * @param version UUID version 1 to 8.
+ * @param out Receives the handle; release it with vscuuid_generator_destroy().
+ * @return VSCUUID_OK, or VSCUUID_ERROR_INVALID_ARGUMENT for an unknown version or null out.
+ */
+vscuuid_status vscuuid_generator_create(int version, vscuuid_generator** out) {
+  if (out == nullptr || version < 1 || version > 8) {
+    return VSCUUID_ERROR_INVALID_ARGUMENT;
+  }
+  *out = nullptr;
+  return Guard([&] {
+    auto type = static_cast<vscuuid::UuidFactory::UuidType>(version - 1);
+    *out = new vscuuid_generator{version, vscuuid::UuidFactory::Create(type)};
+    return VSCUUID_OK;
+  });
+}
+
+/**
+ * @brief Releases a generator handle. Passing NULL is a no-op.
+ */
+void vscuuid_generator_destroy(vscuuid_generator* generator) {
+  delete generator;
+}
+
+/**
+ * @brief Generates n UUIDs into a caller-owned buffer of 16 * n bytes.
+ *
+ * Uses the generator's batch path, so random versions draw their entropy in
+ * bulk. Version 3 and 5 handles produce the UUIDs of their default name.
+ */
+vscuuid_status vscuuid_generate_n(vscuuid_generator* generator, uint8_t* out, size_t n) {
+  if (generator == nullptr || (out == nullptr && n != 0)) {
+    return VSCUUID_ERROR_INVALID_ARGUMENT;
+  }
+  return Guard([&] {
+    vscuuid::Uuid chunk[kChunk];
+    for (std::size_t done = 0; done < n;) {
+      std::size_t count = std::min(kChunk, n - done);
+      generator->generator->GenerateUuids(std::span<vscuuid::Uuid>(chunk, count));
+      std::memcpy(out + done * VSCUUID_BYTES, chunk, count * VSCUUID_BYTES);
+      done += count;
+    }
+    return VSCUUID_OK;
+  });
+}
+
+/**
+ * @brief Derives name-based UUIDs for n names in one namespace.
+ *
+ * The namespace is hashed once for the whole batch. Results are identical to
+ * UuidV3Generator/UuidV5Generator::GenerateUuid with the same arguments.
+ *
+ * @return VSCUUID_ERROR_INVALID_ARGUMENT if the handle is not version 3 or 5.
+ */
+vscuuid_status vscuuid_generate_names_n(vscuuid_generator* generator, const char* namespace_uuid,
+                                        const char* const* names, const size_t* name_lengths,
+                                        size_t n, uint8_t* out) {
+  if (generator == nullptr || namespace_uuid == nullptr || (generator->version != 3 && generator->version != 5) ||
+      (n != 0 && (names == nullptr || name_lengths == nullptr || out == nullptr))) {
+    return VSCUUID_ERROR_INVALID_ARGUMENT;
+  }
+  return Guard([&] {
+    vscuuid::NameHasher hasher(generator->version, namespace_uuid);
+    for (std::size_t i = 0; i < n; ++i) {
+      if (names[i] == nullptr && name_lengths[i] != 0) {
+        return VSCUUID_ERROR_INVALID_ARGUMENT;
+      }
+      vscuuid::Uuid uuid = hasher.Hash(std::string_view(names[i], name_lengths[i]));
+      std::memcpy(out + i * VSCUUID_BYTES, uuid.bytes().data(), VSCUUID_BYTES);
+    }
+    return VSCUUID_OK;
+  });
+}
+
+/**
+ * @brief Formats n UUIDs as back-to-back 36 character records.
+ *
+ * @param out_size Capacity of out in characters; must be at least 36 * n.
+ */
+vscuuid_status vscuuid_format_n(const uint8_t* uuids, size_t n, char* out, size_t out_size) {
+  if (n != 0 && (uuids == nullptr || out == nullptr)) {
+    return VSCUUID_ERROR_INVALID_ARGUMENT;
+  }
+  if (out_size / VSCUUID_STRING_LENGTH < n) {
+    return VSCUUID_ERROR_BUFFER_TOO_SMALL;
+  }
+  return Guard([&] {
+    vscuuid::Uuid chunk[kChunk];
+    for (std::size_t done = 0; done < n;) {
+      std::size_t count = std::min(kChunk, n - done);
+      std::memcpy(chunk, uuids + done * VSCUUID_BYTES, count * VSCUUID_BYTES);
+      vscuuid::FormatUuids(std::span<const vscuuid::Uuid>(chunk, count),
+                           std::span<char>(out + done * VSCUUID_STRING_LENGTH, count * VSCUUID_STRING_LENGTH));
+      done += count;
+    }
+    return VSCUUID_OK;
+  });
+}
+
+/**
+ * @brief Parses n back-to-back 36 character records.
+ *
+ * Either letter case is accepted.
+ *
+ * @param parsed Optional; receives the number of records parsed.
+ * @return VSCUUID_ERROR_PARSE at the first malformed record.
+ */
+vscuuid_status vscuuid_parse_n(const char* text, size_t n, uint8_t* out, size_t* parsed) {
+  if (parsed != nullptr) {
+    *parsed = 0;
+  }
+  if (n != 0 && (text == nullptr || out == nullptr)) {
+    return VSCUUID_ERROR_INVALID_ARGUMENT;
+  }
+  return Guard([&] {
+    vscuuid::Uuid chunk[kChunk];
+    for (std::size_t done = 0; done < n;) {
+      std::size_t count = std::min(kChunk, n - done);
+      std::size_t valid = vscuuid::ParseUuids(
+          std::span<const char>(text + done * VSCUUID_STRING_LENGTH, count * VSCUUID_STRING_LENGTH),
+          std::span<vscuuid::Uuid>(chunk, count));
+      std::memcpy(out + done * VSCUUID_BYTES, chunk, valid * VSCUUID_BYTES);
+      done += valid;
+      if (parsed != nullptr) {
+        *parsed = done;
+      }
+      if (valid != count) {
+        return VSCUUID_ERROR_PARSE;
+      }
+    }
+    return VSCUUID_OK;
+  });
+}
+
+}
@@ -1,8 +1,39 @@
 #include <iostream>
 #include <unordered_set>
 #include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <coroutine>
 #include <cstring>
+#include <deque>
+#include <functional>
+#include <fstream>
+#include <ranges>
+#include <thread>
+#include <vector>
 #include "vscuuid/uuid_factory.hh"
+#include "vscuuid/deterministic_generator.hh"
+#include "vscuuid/clock_sequence_manager.hh"
+#include "vscuuid/cpu_features.hh"
+#include "vscuuid/entropy_source.hh"
+#include "vscuuid/name_cache.hh"
+#include "vscuuid/name_pipeline.hh"
+#include "vscuuid/per_cpu.hh"
+#include "vscuuid/uuid_async.hh"
+#include "vscuuid/uuid_codec.hh"
+#include "vscuuid/uuid_columns.hh"
+#include "vscuuid/uuid_convert.hh"
+#include "vscuuid/uuid_index.hh"
+#include "vscuuid/uuid_scanner.hh"
+#include "vscuuid/v8_layout.hh"
+#include "vscuuid/vscuuid_c.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 bool debug_mode = false;
 
@@ -214,6 +245,1056 @@ void TestUuidV8() {
   }
 }
 
+void TestUuidFormatting() {
+  std::cout << "[TEST] Testing allocation-free UUID formatting" << std::endl;
+  const std::string text = "6ba7b810-9dad-11d1-80b4-00c04fd430c8";
+  vscuuid::Uuid uuid = vscuuid::Uuid::Parse(text);
+
+  std::array<char, vscuuid::kUuidStringLength> buffer;
+  uuid.FormatTo(buffer);
+  if (std::string_view(buffer.data(), buffer.size()) == text && uuid.ToString() == text &&
+      uuid.ToUuidString().view() == text) {
+    std::cout << "[PASS] UUID round-trips through text." << std::endl;
+  } else {
+    std::cerr << "[FAIL] UUID text round-trip mismatch." << std::endl;
+  }
+
+  vscuuid::Uuid upper;
+  if (vscuuid::Uuid::TryParse("6BA7B810-9DAD-11D1-80B4-00C04FD430C8", &upper) && upper == uuid) {
+    std::cout << "[PASS] Upper-case UUID parsed correctly." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Upper-case UUID was not parsed." << std::endl;
+  }
+
+  vscuuid::Uuid rejected;
+  if (!vscuuid::Uuid::TryParse("6ba7b810-9dad-11d1-80b4-00c04fd430cg", &rejected) &&
+      !vscuuid::Uuid::TryParse("6ba7b810-9dad-11d1-80b4-00c04fd430c", &rejected)) {
+    std::cout << "[PASS] Malformed UUIDs are rejected." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Malformed UUID was accepted." << std::endl;
+  }
+
+  std::ostringstream oss;
+  oss << uuid;
+  if (oss.str() == text) {
+    std::cout << "[PASS] UUID streams without a temporary string." << std::endl;
+  } else {
+    std::cerr << "[FAIL] UUID stream output is incorrect." << std::endl;
+  }
+
+  vscuuid::UuidV4Generator generator;
+  generator.GenerateTo(buffer);
+  vscuuid::UuidString generated = generator.GenerateString();
+  if (buffer[14] == '4' && generated.view()[14] == '4' && generated.c_str()[36] == '\0') {
+    std::cout << "[PASS] Generators write into caller buffers." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Generator buffer output is incorrect." << std::endl;
+  }
+
+  vscuuid::UuidV5Generator v5_generator;
+  v5_generator.GenerateTo(text, "example", buffer);
+  if (std::string_view(buffer.data(), buffer.size()) == v5_generator.Generate(text, "example")) {
+    std::cout << "[PASS] Name-based buffer output matches string output." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Name-based buffer output differs from string output." << std::endl;
+  }
+}
+
+void TestUuidScanner() {
+  std::cout << "[TEST] Testing UUID scanner" << std::endl;
+  vscuuid::UuidV4Generator generator;
+  std::string haystack;
+  std::vector<std::pair<std::size_t, vscuuid::Uuid>> expected;
+  for (int i = 0; i < 200; ++i) {
+    haystack += "request_id=";
+    haystack.append(static_cast<std::size_t>(i % 37), 'x');
+    vscuuid::Uuid uuid = generator.GenerateUuid();
+    expected.emplace_back(haystack.size(), uuid);
+    std::string text = uuid.ToString();
+    if (i % 2 == 1) {
+      std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::toupper(c); });
+    }
+    haystack += text;
+    haystack += " -- a1-b2-c3-d4 ";
+  }
+  // Near misses: a hex digit glued to either end, and a truncated final group.
+  haystack += "a6ba7b810-9dad-11d1-80b4-00c04fd430c8 6ba7b810-9dad-11d1-80b4-00c04fd430c8f ";
+  haystack += "6ba7b810-9dad-11d1-80b4-00c04fd430c";
+
+  std::vector<vscuuid::UuidMatch> matches;
+  std::size_t count = vscuuid::ScanUuids(haystack, [&](const vscuuid::UuidMatch& match) {
+    matches.push_back(match);
+  });
+  bool correct = count == expected.size() && matches.size() == expected.size();
+  for (std::size_t i = 0; correct && i < expected.size(); ++i) {
+    correct = matches[i].offset == expected[i].first && matches[i].uuid == expected[i].second;
+  }
+  if (correct) {
+    std::cout << "[PASS] Scanner found every UUID at the right offset." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Scanner results are incorrect (" << count << " of " << expected.size() << ")." << std::endl;
+  }
+
+  const std::string path = "vscuuid_scanner_test.log";
+  std::size_t file_expected = 0;
+  {
+    std::ofstream out(path, std::ios::binary);
+    std::string line = "GET /api/items id=6ba7b810-9dad-11d1-80b4-00c04fd430c8 status=200\n";
+    // Large enough to span several scan chunks, so chunk boundaries are exercised.
+    for (int i = 0; i < 150000; ++i) {
+      out << line;
+      ++file_expected;
+    }
+  }
+  std::size_t previous_offset = 0;
+  bool ordered = true;
+  std::size_t file_count = vscuuid::ScanUuidsInFile(path, [&](const vscuuid::UuidMatch& match) {
+    ordered = ordered && (match.offset >= previous_offset);
+    previous_offset = match.offset;
+  }, 4);
+  std::remove(path.c_str());
+  if (file_count == file_expected && ordered) {
+    std::cout << "[PASS] File scanner found every UUID in order." << std::endl;
+  } else {
+    std::cerr << "[FAIL] File scanner found " << file_count << " of " << file_expected << " UUIDs." << std::endl;
+  }
+}
+
+struct DetachedTask {
+  struct promise_type {
+    DetachedTask get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+struct QueueExecutor {
+  std::deque<std::function<void()>> jobs;
+
+  void operator()(std::function<void()> work) { jobs.push_back(std::move(work)); }
+
+  void RunAll() {
+    while (!jobs.empty()) {
+      auto job = std::move(jobs.front());
+      jobs.pop_front();
+      job();
+    }
+  }
+};
+
+DetachedTask GenerateOnExecutor(vscuuid::UuidGeneratorBase& generator, QueueExecutor& executor,
+                                std::vector<vscuuid::Uuid>* out) {
+  *out = co_await vscuuid::GenerateAsync(generator, executor, 64);
+  out->push_back(co_await vscuuid::GenerateAsync(generator, executor));
+}
+
+void TestUuidStream() {
+  std::cout << "[TEST] Testing lazy UUID streams" << std::endl;
+  vscuuid::UuidV4Generator generator;
+
+  std::unordered_set<std::string> uuid_set;
+  std::size_t count = 0;
+  for (const vscuuid::Uuid& uuid : generator.Stream(100) | std::views::take(1000)) {
+    uuid_set.insert(uuid.ToString());
+    ++count;
+  }
+  if (count == 1000 && uuid_set.size() == 1000) {
+    std::cout << "[PASS] Stream yields unique UUIDs across batch refills." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Stream produced " << count << " UUIDs, " << uuid_set.size() << " unique." << std::endl;
+  }
+
+  auto versions = generator.Stream() | std::views::transform([](const vscuuid::Uuid& uuid) { return uuid.version(); }) |
+                  std::views::take(10);
+  bool all_v4 = true;
+  for (int version : versions) {
+    all_v4 = all_v4 && version == 4;
+  }
+  if (all_v4) {
+    std::cout << "[PASS] Stream composes with standard views." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Stream yielded a wrong version." << std::endl;
+  }
+
+  QueueExecutor executor;
+  std::vector<vscuuid::Uuid> async_uuids;
+  GenerateOnExecutor(generator, executor, &async_uuids);
+  bool suspended = async_uuids.empty() && executor.jobs.size() == 1;
+  executor.RunAll();
+  if (suspended && async_uuids.size() == 65 && async_uuids.back().version() == 4) {
+    std::cout << "[PASS] Async generation resumes on the executor." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Async generation did not complete as expected." << std::endl;
+  }
+}
+
+void TestNamePipeline() {
+  std::cout << "[TEST] Testing name-based UUID pipeline" << std::endl;
+  const std::string namespace_uuid = "6ba7b810-9dad-11d1-80b4-00c04fd430c8";
+  std::string input;
+  for (int i = 0; i < 5000; ++i) {
+    input += "customer-" + std::to_string(i) + (i % 3 == 0 ? "\r\n" : "\n");
+  }
+  input += "last-without-newline";
+
+  vscuuid::NamePipelineOptions options;
+  options.thread_count = 4;
+  options.batch_bytes = 1024;
+  options.max_batches_in_flight = 3;
+  std::ostringstream text_output;
+  std::size_t lines = vscuuid::DeriveNameUuids(input, namespace_uuid, text_output, options);
+
+  vscuuid::UuidV5Generator generator;
+  std::istringstream results(text_output.str());
+  std::string row;
+  std::size_t rows = 0;
+  bool matches = true;
+  while (std::getline(results, row)) {
+    std::size_t comma = row.rfind(',');
+    std::string key = row.substr(0, comma);
+    matches = matches && row.substr(comma + 1) == generator.Generate(namespace_uuid, key) &&
+              key == (rows < 5000 ? "customer-" + std::to_string(rows) : "last-without-newline");
+    ++rows;
+  }
+  if (lines == 5001 && rows == 5001 && matches) {
+    std::cout << "[PASS] Pipeline output is complete, ordered and matches UuidV5Generator." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Pipeline produced " << rows << " rows for " << lines << " lines." << std::endl;
+  }
+
+  options.format = vscuuid::NameOutputFormat::kBinary;
+  options.type = vscuuid::UuidFactory::UuidType::V3;
+  std::ostringstream binary_output;
+  vscuuid::DeriveNameUuids(input, namespace_uuid, binary_output, options);
+  vscuuid::UuidV3Generator v3_generator;
+  std::string binary = binary_output.str();
+  vscuuid::Uuid first = v3_generator.GenerateUuid(namespace_uuid, "customer-0");
+  if (binary.size() == 5001 * 16 && std::memcmp(binary.data(), first.bytes().data(), 16) == 0) {
+    std::cout << "[PASS] Binary V3 pipeline output is correct." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Binary V3 pipeline output is incorrect." << std::endl;
+  }
+}
+
+void TestUuidIndex() {
+  std::cout << "[TEST] Testing static UUID index" << std::endl;
+  vscuuid::UuidV4Generator generator;
+  std::vector<vscuuid::Uuid> members(5000);
+  std::vector<vscuuid::Uuid> strangers(5000);
+  generator.GenerateUuids(members);
+  generator.GenerateUuids(strangers);
+  members.push_back(members.front());
+
+  vscuuid::UuidIndex index = vscuuid::UuidIndex::Build(members);
+  bool correct = index.size() == 5000;
+  for (std::size_t i = 0; correct && i < strangers.size(); ++i) {
+    correct = index.Contains(members[i]) && !index.Contains(strangers[i]);
+  }
+  if (correct) {
+    std::cout << "[PASS] Index answers single lookups correctly." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Index single lookups are incorrect." << std::endl;
+  }
+
+  std::vector<vscuuid::Uuid> queries;
+  for (std::size_t i = 0; i < 1000; ++i) {
+    queries.push_back(i % 2 == 0 ? members[i] : strangers[i]);
+  }
+  std::unique_ptr<bool[]> found(new bool[queries.size()]);
+  const std::string path = "vscuuid_index_test.idx";
+  index.Save(path);
+  vscuuid::UuidIndex mapped = vscuuid::UuidIndex::Open(path);
+  mapped.ContainsBatch(queries, std::span<bool>(found.get(), queries.size()));
+  std::remove(path.c_str());
+  bool batch_correct = mapped.size() == index.size();
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    batch_correct = batch_correct && found[i] == (i % 2 == 0);
+  }
+  if (batch_correct) {
+    std::cout << "[PASS] Mapped index answers batch lookups correctly." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Mapped index batch lookups are incorrect." << std::endl;
+  }
+
+  vscuuid::UuidIndex empty = vscuuid::UuidIndex::Build({});
+  if (!empty.Contains(members.front())) {
+    std::cout << "[PASS] Empty index contains nothing." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Empty index reported a member." << std::endl;
+  }
+
+  // A header claiming UINT64_MAX entries must not wrap the size check, with or
+  // without the padding slot behind it.
+  std::size_t rejected = 0;
+  for (std::size_t file_size : {std::size_t{64}, std::size_t{80}}) {
+    std::string header(file_size, '\0');
+    std::memcpy(header.data(), "VSCUIDX1", 8);
+    std::memset(header.data() + 8, 0xFF, 8);
+    std::ofstream(path, std::ios::binary | std::ios::trunc)
+        .write(header.data(), static_cast<std::streamsize>(header.size()));
+    try {
+      vscuuid::UuidIndex::Open(path);
+    } catch (const std::runtime_error&) {
+      ++rejected;
+    }
+  }
+  std::remove(path.c_str());
+  if (rejected == 2) {
+    std::cout << "[PASS] Index files with a corrupt entry count are rejected." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Index file with a corrupt entry count was accepted." << std::endl;
+  }
+}
+
+void TestEntropyForkSafety() {
+  std::cout << "[TEST] Testing entropy source across fork()" << std::endl;
+#if defined(__unix__) || defined(__APPLE__)
+  constexpr int kChildren = 8;
+  constexpr std::size_t kPerChild = 256;
+  vscuuid::UuidV4Generator v4_generator;
+  vscuuid::UuidV1Generator v1_generator;
+  // Warm up the parent so every child inherits a partially consumed buffer.
+  std::unordered_set<std::string> seen = {v4_generator.Generate(), v1_generator.Generate()};
+
+  int fds[2];
+  if (pipe(fds) != 0) {
+    std::cerr << "[FAIL] Could not create pipe." << std::endl;
+    return;
+  }
+  for (int child = 0; child < kChildren; ++child) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      close(fds[0]);
+      std::vector<vscuuid::Uuid> uuids(kPerChild);
+      v4_generator.GenerateUuids(uuids);
+      uuids.back() = v1_generator.GenerateUuid();
+      ssize_t written = write(fds[1], uuids.data(), uuids.size() * sizeof(vscuuid::Uuid));
+      _exit(written == static_cast<ssize_t>(uuids.size() * sizeof(vscuuid::Uuid)) ? 0 : 1);
+    }
+  }
+  close(fds[1]);
+
+  std::vector<vscuuid::Uuid> received(kChildren * kPerChild);
+  std::size_t bytes = 0;
+  char* out = reinterpret_cast<char*>(received.data());
+  while (bytes < received.size() * sizeof(vscuuid::Uuid)) {
+    ssize_t got = read(fds[0], out + bytes, received.size() * sizeof(vscuuid::Uuid) - bytes);
+    if (got <= 0) {
+      break;
+    }
+    bytes += static_cast<std::size_t>(got);
+  }
+  close(fds[0]);
+  bool children_ok = true;
+  for (int child = 0; child < kChildren; ++child) {
+    int status = 0;
+    wait(&status);
+    children_ok = children_ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+  }
+
+  std::unordered_set<std::string> node_ids;
+  for (std::size_t i = 0; i < received.size(); ++i) {
+    seen.insert(received[i].ToString());
+    if (i % kPerChild == kPerChild - 1) {
+      node_ids.insert(received[i].ToString().substr(24));
+    }
+  }
+  if (children_ok && bytes == received.size() * sizeof(vscuuid::Uuid) &&
+      seen.size() == received.size() + 2 && node_ids.size() == kChildren) {
+    std::cout << "[PASS] Forked children produce distinct UUIDs and node IDs." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Forked children produced colliding UUIDs." << std::endl;
+  }
+#else
+  std::cout << "[INFO] fork() is not available; skipping." << std::endl;
+#endif
+}
+
+void TestIsaDispatch() {
+  std::cout << "[TEST] Testing vectorized kernels against the scalar tier" << std::endl;
+  const vscuuid::IsaTier original = vscuuid::ActiveIsaTier();
+  const vscuuid::IsaTier detected = vscuuid::DetectedIsaTier();
+  std::cout << "[INFO] Detected ISA tier: " << vscuuid::IsaTierName(detected) << std::endl;
+
+  // An odd count exercises every kernel's remainder path.
+  vscuuid::UuidV4Generator generator;
+  std::vector<vscuuid::Uuid> uuids(1003);
+  generator.GenerateUuids(uuids);
+  uuids[0] = vscuuid::Uuid();
+  uuids[1].bytes().fill(0xFF);
+
+  vscuuid::SetIsaTier(vscuuid::IsaTier::kScalar);
+  std::string expected_text(uuids.size() * vscuuid::kUuidStringLength, '\0');
+  vscuuid::FormatUuids(uuids, expected_text);
+  std::string corpus;
+  for (std::size_t i = 0; i < 200; ++i) {
+    corpus += "id=" + uuids[i].ToString() + (i % 7 == 0 ? "f " : " ") + std::string(i % 13, 'x');
+  }
+  std::vector<std::size_t> expected_offsets;
+  vscuuid::ScanUuids(corpus, [&](const vscuuid::UuidMatch& match) { expected_offsets.push_back(match.offset); });
+
+  for (vscuuid::IsaTier tier : {vscuuid::IsaTier::kScalar, vscuuid::IsaTier::kAvx2, vscuuid::IsaTier::kAvx512}) {
+    if (tier > detected) {
+      std::cout << "[INFO] Skipping unsupported tier " << vscuuid::IsaTierName(tier) << std::endl;
+      continue;
+    }
+    vscuuid::SetIsaTier(tier);
+    const std::string name(vscuuid::IsaTierName(tier));
+
+    std::string text(expected_text.size(), '\0');
+    vscuuid::FormatUuids(uuids, text);
+    std::vector<vscuuid::Uuid> parsed(uuids.size());
+    std::size_t parsed_count = vscuuid::ParseUuids(text, parsed);
+    std::string upper = text;
+    std::transform(upper.begin(), upper.end(), upper.begin(), [](unsigned char c) { return std::toupper(c); });
+    std::vector<vscuuid::Uuid> parsed_upper(uuids.size());
+    std::size_t upper_count = vscuuid::ParseUuids(upper, parsed_upper);
+    if (text == expected_text && parsed_count == uuids.size() && parsed == uuids &&
+        upper_count == uuids.size() && parsed_upper == uuids) {
+      std::cout << "[PASS] " << name << " format and parse match the scalar kernels." << std::endl;
+    } else {
+      std::cerr << "[FAIL] " << name << " format or parse differs from the scalar kernels." << std::endl;
+    }
+
+    bool stops_correctly = true;
+    for (std::size_t bad : {std::size_t{0}, std::size_t{5}, std::size_t{6}, std::size_t{1001}}) {
+      for (std::size_t column : {std::size_t{0}, std::size_t{13}, std::size_t{17}, std::size_t{35}}) {
+        std::string corrupted = text;
+        corrupted[bad * vscuuid::kUuidStringLength + column] = 'g';
+        if (vscuuid::ParseUuids(corrupted, parsed) != bad) {
+          stops_correctly = false;
+        }
+      }
+    }
+    if (stops_correctly) {
+      std::cout << "[PASS] " << name << " parsing stops at the first malformed record." << std::endl;
+    } else {
+      std::cerr << "[FAIL] " << name << " parsing accepted a malformed record." << std::endl;
+    }
+
+    std::vector<std::size_t> offsets;
+    vscuuid::ScanUuids(corpus, [&](const vscuuid::UuidMatch& match) { offsets.push_back(match.offset); });
+    if (offsets == expected_offsets) {
+      std::cout << "[PASS] " << name << " scanner matches the scalar scanner." << std::endl;
+    } else {
+      std::cerr << "[FAIL] " << name << " scanner differs from the scalar scanner." << std::endl;
+    }
+
+    std::vector<uint8_t> random(4096);
+    vscuuid::EntropySource::Fill(random);
+    if (std::count(random.begin(), random.end(), 0) < 64) {
+      std::cout << "[PASS] " << name << " entropy kernel produces output." << std::endl;
+    } else {
+      std::cerr << "[FAIL] " << name << " entropy kernel output looks empty." << std::endl;
+    }
+  }
+
+  std::string too_small(vscuuid::kUuidStringLength, '\0');
+  try {
+    vscuuid::FormatUuids(uuids, too_small);
+    std::cerr << "[FAIL] Undersized format buffer was accepted." << std::endl;
+  } catch (const std::invalid_argument&) {
+    std::cout << "[PASS] Undersized format buffer is rejected." << std::endl;
+  }
+  vscuuid::SetIsaTier(original);
+}
+
+void TestCInterface() {
+  std::cout << "[TEST] Testing the C interface" << std::endl;
+  vscuuid_generator* generator = nullptr;
+  if (vscuuid_abi_version() == VSCUUID_C_ABI_VERSION &&
+      vscuuid_generator_create(0, &generator) == VSCUUID_ERROR_INVALID_ARGUMENT &&
+      vscuuid_generator_create(4, &generator) == VSCUUID_OK && generator != nullptr) {
+    std::cout << "[PASS] C generator handle created." << std::endl;
+  } else {
+    std::cerr << "[FAIL] C generator handle creation failed." << std::endl;
+    return;
+  }
+
+  const std::size_t count = 1000;
+  std::vector<uint8_t> bytes(count * VSCUUID_BYTES);
+  std::string text(count * VSCUUID_STRING_LENGTH, '\0');
+  std::vector<uint8_t> round_trip(bytes.size());
+  std::size_t parsed = 0;
+  bool ok = vscuuid_generate_n(generator, bytes.data(), count) == VSCUUID_OK &&
+            vscuuid_format_n(bytes.data(), count, text.data(), text.size()) == VSCUUID_OK &&
+            vscuuid_parse_n(text.data(), count, round_trip.data(), &parsed) == VSCUUID_OK;
+  vscuuid_generator_destroy(generator);
+  if (ok && parsed == count && round_trip == bytes && text[14] == '4' &&
+      text.substr(0, VSCUUID_STRING_LENGTH) ==
+          vscuuid::Uuid::Parse(text.substr(0, VSCUUID_STRING_LENGTH)).ToString()) {
+    std::cout << "[PASS] C batch generate, format and parse round-trip." << std::endl;
+  } else {
+    std::cerr << "[FAIL] C batch round-trip failed." << std::endl;
+  }
+
+  text[700 * VSCUUID_STRING_LENGTH + 8] = 'x';
+  if (vscuuid_parse_n(text.data(), count, round_trip.data(), &parsed) == VSCUUID_ERROR_PARSE && parsed == 700 &&
+      vscuuid_format_n(bytes.data(), count, text.data(), text.size() - 1) == VSCUUID_ERROR_BUFFER_TOO_SMALL) {
+    std::cout << "[PASS] C interface reports malformed input and short buffers." << std::endl;
+  } else {
+    std::cerr << "[FAIL] C interface error reporting is incorrect." << std::endl;
+  }
+
+  const std::string namespace_uuid = "6ba7b810-9dad-11d1-80b4-00c04fd430c8";
+  const char* names[] = {"example", "another"};
+  const std::size_t lengths[] = {7, 7};
+  uint8_t derived[2 * VSCUUID_BYTES];
+  vscuuid::UuidV5Generator v5_generator;
+  vscuuid_generator* v5_handle = nullptr;
+  ok = vscuuid_generator_create(5, &v5_handle) == VSCUUID_OK &&
+       vscuuid_generate_names_n(v5_handle, namespace_uuid.c_str(), names, lengths, 2, derived) == VSCUUID_OK;
+  vscuuid_generator_destroy(v5_handle);
+  vscuuid::Uuid first = v5_generator.GenerateUuid(namespace_uuid, "example");
+  vscuuid::Uuid second = v5_generator.GenerateUuid(namespace_uuid, "another");
+  if (ok && std::memcmp(derived, first.bytes().data(), VSCUUID_BYTES) == 0 &&
+      std::memcmp(derived + VSCUUID_BYTES, second.bytes().data(), VSCUUID_BYTES) == 0) {
+    std::cout << "[PASS] C name-based batch matches the C++ generator." << std::endl;
+  } else {
+    std::cerr << "[FAIL] C name-based batch differs from the C++ generator." << std::endl;
+  }
+}
+
+void TestUuidConversion() {
+  std::cout << "[TEST] Testing V1/V6 conversion" << std::endl;
+  // Test vectors from RFC 9562, appendix A.
+  const vscuuid::Uuid v1 = vscuuid::Uuid::Parse("C232AB00-9414-11EC-B3C8-9F6BDECED846");
+  const vscuuid::Uuid v6 = vscuuid::Uuid::Parse("1EC9414C-232A-6B00-B3C8-9F6BDECED846");
+  if (vscuuid::ConvertV1ToV6(v1) == v6 && vscuuid::ConvertV6ToV1(v6) == v1) {
+    std::cout << "[PASS] RFC 9562 V1/V6 test vectors convert both ways." << std::endl;
+  } else {
+    std::cerr << "[FAIL] RFC 9562 V1/V6 test vectors did not convert." << std::endl;
+  }
+
+  vscuuid::UuidV1Generator v1_generator;
+  std::vector<vscuuid::Uuid> originals(1001);
+  v1_generator.GenerateUuids(originals);
+  std::vector<vscuuid::Uuid> expected(originals.size());
+  for (std::size_t i = 0; i < originals.size(); ++i) {
+    expected[i] = vscuuid::ConvertV1ToV6(originals[i]);
+  }
+  const vscuuid::IsaTier original_tier = vscuuid::ActiveIsaTier();
+  for (vscuuid::IsaTier tier : {vscuuid::IsaTier::kScalar, vscuuid::IsaTier::kAvx2, vscuuid::IsaTier::kAvx512}) {
+    if (vscuuid::SetIsaTier(tier) != tier) {
+      continue;
+    }
+    std::vector<vscuuid::Uuid> converted(originals.size());
+    vscuuid::ConvertV1ToV6(originals, converted);
+    std::vector<vscuuid::Uuid> in_place = converted;
+    vscuuid::ConvertV6ToV1(in_place, in_place);
+    if (converted == expected && in_place == originals) {
+      std::cout << "[PASS] " << vscuuid::IsaTierName(tier) << " span conversion round-trips." << std::endl;
+    } else {
+      std::cerr << "[FAIL] " << vscuuid::IsaTierName(tier) << " span conversion is incorrect." << std::endl;
+    }
+  }
+  vscuuid::SetIsaTier(original_tier);
+
+  std::vector<vscuuid::Uuid> mixed = {v1, v6, vscuuid::Uuid::Parse("6ba7b810-9dad-41d1-80b4-00c04fd430c8")};
+  std::vector<uint64_t> timestamps(mixed.size());
+  std::vector<uint16_t> clock_sequences(mixed.size());
+  std::vector<uint64_t> nodes(mixed.size());
+  vscuuid::ExtractTimeFields(mixed, {timestamps, clock_sequences, nodes});
+  if (timestamps[0] == 0x1EC9414C232AB00ULL && timestamps[1] == timestamps[0] && timestamps[2] == 0 &&
+      clock_sequences[0] == 0x33C8 && nodes[0] == 0x9F6BDECED846ULL && nodes[2] == 0x00C04FD430C8ULL) {
+    std::cout << "[PASS] Time fields extracted into columns." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Time field extraction is incorrect." << std::endl;
+  }
+
+  vscuuid::UuidV6Generator v6_generator;
+  vscuuid::Uuid earlier = v6_generator.GenerateUuid();
+  std::vector<uint64_t> generated_timestamps(2);
+  std::vector<vscuuid::Uuid> pair = {vscuuid::ConvertV1ToV6(v1_generator.GenerateUuid()), earlier};
+  vscuuid::ExtractTimeFields(pair, {generated_timestamps, {}, {}});
+  if (earlier.version() == 6 && generated_timestamps[1] <= generated_timestamps[0] &&
+      generated_timestamps[0] - generated_timestamps[1] < 10000000ULL) {
+    std::cout << "[PASS] UuidV6Generator uses the RFC 9562 layout." << std::endl;
+  } else {
+    std::cerr << "[FAIL] UuidV6Generator layout does not match V1 timestamps." << std::endl;
+  }
+}
+
+void TestDeterministicGenerator() {
+  std::cout << "[TEST] Testing deterministic counter-based generation" << std::endl;
+  // Random123 known answer for Philox4x32-10 with zero key and counter:
+  // 6627e8d5 e169c58d bc57ac4c 9b00dbd8, before version and variant are stamped.
+  vscuuid::DeterministicUuidGenerator zero(8, 0);
+  if (zero.At(0).ToString() == "6627e8d5-e169-858d-bc57-ac4c9b00dbd8") {
+    std::cout << "[PASS] Philox output matches the reference implementation." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Philox output differs from the reference: " << zero.At(0) << std::endl;
+  }
+
+  for (int version : {4, 7, 8}) {
+    vscuuid::DeterministicUuidGenerator first(version, 42);
+    vscuuid::DeterministicUuidGenerator second(version, 42);
+    std::vector<vscuuid::Uuid> sequential(1000);
+    for (auto& uuid : sequential) {
+      uuid = first.GenerateUuid();
+    }
+
+    // Four workers each produce a quarter of the range out of order.
+    std::vector<vscuuid::Uuid> parallel(sequential.size());
+    std::vector<std::thread> workers;
+    for (std::size_t worker = 4; worker-- > 0;) {
+      workers.emplace_back([&, worker] {
+        second.Generate(worker * 250, std::span<vscuuid::Uuid>(parallel).subspan(worker * 250, 250));
+      });
+    }
+    for (auto& thread : workers) {
+      thread.join();
+    }
+
+    second.Seek(500);
+    std::vector<vscuuid::Uuid> resumed(10);
+    second.GenerateUuids(resumed);
+    std::unordered_set<vscuuid::Uuid> unique(sequential.begin(), sequential.end());
+    bool versions_ok = std::all_of(sequential.begin(), sequential.end(), [&](const vscuuid::Uuid& uuid) {
+      return uuid.version() == version && (uuid.bytes()[8] & 0xC0) == 0x80;
+    });
+    if (parallel == sequential && std::equal(resumed.begin(), resumed.end(), sequential.begin() + 500) &&
+        second.position() == 510 && unique.size() == sequential.size() && versions_ok &&
+        vscuuid::DeterministicUuidGenerator(version, 43).At(0) != sequential[0]) {
+      std::cout << "[PASS] Version " << version << " stream is reproducible and seekable." << std::endl;
+    } else {
+      std::cerr << "[FAIL] Version " << version << " stream is not reproducible." << std::endl;
+    }
+  }
+
+  vscuuid::DeterministicUuidGenerator v7(7, 1, [](uint64_t index) { return 1700000000000ULL + index / 100; });
+  std::vector<uint64_t> timestamps;
+  for (uint64_t index : {0ULL, 99ULL, 100ULL, 123456ULL}) {
+    uint64_t ms = 0;
+    for (int i = 0; i < 6; ++i) {
+      ms = (ms << 8) | v7.At(index).bytes()[i];
+    }
+    timestamps.push_back(ms);
+  }
+  if (timestamps == std::vector<uint64_t>{1700000000000ULL, 1700000000000ULL, 1700000000001ULL, 1700000001234ULL}) {
+    std::cout << "[PASS] Version 7 timestamps come from the injected clock." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Version 7 timestamps ignore the injected clock." << std::endl;
+  }
+
+  try {
+    vscuuid::DeterministicUuidGenerator invalid(1, 0);
+    std::cerr << "[FAIL] Unsupported deterministic version was accepted." << std::endl;
+  } catch (const std::invalid_argument&) {
+    std::cout << "[PASS] Unsupported deterministic version is rejected." << std::endl;
+  }
+}
+
+void TestUuidColumns() {
+  std::cout << "[TEST] Testing columnar output buffers" << std::endl;
+  vscuuid::UuidV4Generator generator;
+  vscuuid::UuidColumn column = vscuuid::GenerateUuidColumn(generator, 1001);
+  std::unordered_set<vscuuid::Uuid> unique(column.uuids().begin(), column.uuids().end());
+  if (reinterpret_cast<std::uintptr_t>(column.values.data()) % vscuuid::kColumnAlignment == 0 &&
+      column.values.size() == 1001 * 16 && column.values.capacity() % vscuuid::kColumnAlignment == 0 &&
+      column.validity.empty() && unique.size() == 1001 && column.uuids()[1000].version() == 4) {
+    std::cout << "[PASS] Generated column is aligned and filled." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Generated column is malformed." << std::endl;
+  }
+
+  const vscuuid::Uuid kept = column.uuids()[8];
+  column.SetNull(7);
+  column.SetNull(1000);
+  column.SetNull(7);
+  const uint8_t* bitmap = column.validity.data();
+  if (column.null_count == 2 && !column.IsValid(7) && column.IsValid(8) && !column.IsValid(1000) &&
+      bitmap[0] == 0x7F && bitmap[125] == 0x00 && column.validity.size() == 126 &&
+      column.uuids()[7].is_nil()) {
+    std::cout << "[PASS] Validity bitmap uses Arrow's LSB bit order." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Validity bitmap is incorrect." << std::endl;
+  }
+
+  vscuuid::UuidTextColumn text = vscuuid::FormatUuidColumn(column);
+  if (text.length == 1001 && text[8] == kept.ToString() && text[7] == std::string(36, ' ') &&
+      text[1000] == std::string(36, ' ') && text[999] == column.uuids()[999].ToString()) {
+    std::cout << "[PASS] Text column has a fixed 36-byte stride." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Text column content is incorrect." << std::endl;
+  }
+
+  std::vector<uint8_t> caller_values(10 * 16);
+  vscuuid::GenerateUuidColumn(generator, caller_values);
+  std::string caller_text(10 * vscuuid::kUuidStringLength, '\0');
+  vscuuid::FormatUuidColumn(caller_values, {}, caller_text);
+  bool rejected = false;
+  try {
+    vscuuid::FormatUuidColumn(caller_values, {}, std::span<char>(caller_text).first(100));
+  } catch (const std::invalid_argument&) {
+    rejected = true;
+  }
+  if (caller_text[14] == '4' && vscuuid::Uuid::Parse(caller_text.substr(0, 36)).bytes()[0] == caller_values[0] &&
+      rejected) {
+    std::cout << "[PASS] Caller-provided column buffers are supported." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Caller-provided column buffers are mishandled." << std::endl;
+  }
+}
+
+void TestV8Layout() {
+  std::cout << "[TEST] Testing compile-time V8 layouts" << std::endl;
+  using OrderId = vscuuid::V8Layout<vscuuid::Field<"tenant", 20>, vscuuid::Field<"ts_ms", 48>,
+                                    vscuuid::Random<54>>;
+  static_assert(OrderId::kPayloadBits == 122 && OrderId::IndexOf<"ts_ms">() == 1);
+
+  const uint64_t tenant = 0xABCDE;
+  const uint64_t ts_ms = 0x0123456789ABULL;
+  vscuuid::Uuid first = OrderId::Pack(tenant, ts_ms);
+  vscuuid::Uuid second = OrderId::Pack(tenant, ts_ms);
+  if (first.version() == 8 && (first.bytes()[8] & 0xC0) == 0x80 && OrderId::Get<"tenant">(first) == tenant &&
+      OrderId::Get<"ts_ms">(first) == ts_ms && first != second &&
+      first.ToString().substr(0, 5) == "abcde") {
+    std::cout << "[PASS] Fields round-trip around the version and variant bits." << std::endl;
+  } else {
+    std::cerr << "[FAIL] V8 layout fields did not round-trip: " << first << std::endl;
+  }
+
+  // Every field straddles a reserved region or word boundary.
+  using Straddling = vscuuid::V8Layout<vscuuid::Field<"a", 46>, vscuuid::Field<"b", 16>,
+                                       vscuuid::Field<"c", 60>>;
+  const uint64_t a = 0x2AAAAAAAAAAAULL;
+  const uint64_t b = 0xBEEF;
+  const uint64_t c = 0x0FEDCBA987654321ULL;
+  vscuuid::Uuid packed = Straddling::Pack(a, b, c);
+  if (Straddling::Get<"a">(packed) == a && Straddling::Get<"b">(packed) == b &&
+      Straddling::Get<"c">(packed) == c && packed.version() == 8 &&
+      Straddling::Get<"b">(Straddling::Pack(0, 0x1BEEF, 0)) == b) {
+    std::cout << "[PASS] Straddling fields round-trip and oversized values are truncated." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Straddling V8 fields did not round-trip." << std::endl;
+  }
+
+  std::vector<uint64_t> tenants(300);
+  std::vector<uint64_t> timestamps(300);
+  for (std::size_t i = 0; i < tenants.size(); ++i) {
+    tenants[i] = i * 7;
+    timestamps[i] = 1700000000000ULL + i;
+  }
+  std::vector<vscuuid::Uuid> batch(tenants.size());
+  OrderId::PackBatch(batch, tenants, timestamps);
+  std::vector<uint64_t> unpacked(batch.size());
+  OrderId::GetBatch<"ts_ms">(batch, unpacked);
+  std::unordered_set<vscuuid::Uuid> unique(batch.begin(), batch.end());
+  if (unpacked == timestamps && OrderId::Get<"tenant">(batch[299]) == 299 * 7 && unique.size() == batch.size()) {
+    std::cout << "[PASS] Batch packing over struct-of-arrays input." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Batch packing produced wrong values." << std::endl;
+  }
+}
+
+void TestPerCpuState() {
+  std::cout << "[TEST] Testing the per-CPU state backend" << std::endl;
+  std::cout << "[INFO] Per-CPU updates use " << (vscuuid::PerCpuUsesRseq() ? "rseq" : "atomics") << "."
+            << std::endl;
+
+  constexpr int kThreads = 4;
+  constexpr int kDraws = 16;
+  vscuuid::ClockSequenceManager manager(vscuuid::StateBackend::kPerCpu);
+  std::vector<uint16_t> sequences(kThreads * kDraws);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < kDraws; ++i) {
+        sequences[t * kDraws + i] = manager.GetClockSequence();
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  std::unordered_set<uint16_t> distinct(sequences.begin(), sequences.end());
+  bool in_range = std::all_of(sequences.begin(), sequences.end(), [](uint16_t s) { return s < 0x4000; });
+  if (distinct.size() == sequences.size() && in_range) {
+    std::cout << "[PASS] Per-CPU clock sequences are distinct across threads." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Per-CPU clock sequences collided." << std::endl;
+  }
+
+  const vscuuid::EntropyOptions original = vscuuid::EntropySource::options();
+  vscuuid::EntropyOptions options = original;
+  options.backend = vscuuid::StateBackend::kPerCpu;
+  vscuuid::EntropySource::Configure(options);
+
+  std::vector<uint64_t> words(kThreads * 300);
+  threads.clear();
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      // Odd sizes exercise partial blocks.
+      for (int i = 0; i < 100; ++i) {
+        uint64_t draw[3];
+        vscuuid::EntropySource::Fill(std::span<uint8_t>(reinterpret_cast<uint8_t*>(draw), sizeof(draw)));
+        std::copy(draw, draw + 3, words.begin() + t * 300 + i * 3);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  std::vector<uint8_t> large(5000);
+  vscuuid::EntropySource::Fill(large);
+  std::unordered_set<uint64_t> distinct_words(words.begin(), words.end());
+  if (distinct_words.size() == words.size() &&
+      std::count(large.begin(), large.end(), 0) < static_cast<std::ptrdiff_t>(large.size() / 32)) {
+    std::cout << "[PASS] Per-CPU entropy is distinct across threads." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Per-CPU entropy repeated values." << std::endl;
+  }
+
+  // A one-block interval rekeys a slot on almost every draw, racing readers.
+  options.reseed_interval_bytes = 64;
+  vscuuid::EntropySource::Configure(options);
+  threads.clear();
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 100; ++i) {
+        uint64_t draw[3];
+        vscuuid::EntropySource::Fill(std::span<uint8_t>(reinterpret_cast<uint8_t*>(draw), sizeof(draw)));
+        std::copy(draw, draw + 3, words.begin() + t * 300 + i * 3);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  distinct_words = std::unordered_set<uint64_t>(words.begin(), words.end());
+  if (distinct_words.size() == words.size()) {
+    std::cout << "[PASS] Per-CPU keys are replaced every reseed interval." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Per-CPU entropy repeated values across rekeys." << std::endl;
+  }
+  options.reseed_interval_bytes = original.reseed_interval_bytes;
+  vscuuid::EntropySource::Configure(options);
+
+#if defined(__unix__) || defined(__APPLE__)
+  int fds[2];
+  if (pipe(fds) == 0) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      close(fds[0]);
+      uint64_t child_words[4];
+      vscuuid::EntropySource::Fill(std::span<uint8_t>(reinterpret_cast<uint8_t*>(child_words), sizeof(child_words)));
+      ssize_t written = write(fds[1], child_words, sizeof(child_words));
+      _exit(written == static_cast<ssize_t>(sizeof(child_words)) ? 0 : 1);
+    }
+    close(fds[1]);
+    uint64_t parent_words[4];
+    vscuuid::EntropySource::Fill(std::span<uint8_t>(reinterpret_cast<uint8_t*>(parent_words), sizeof(parent_words)));
+    uint64_t child_words[4] = {};
+    ssize_t got = read(fds[0], child_words, sizeof(child_words));
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (got == static_cast<ssize_t>(sizeof(child_words)) && WIFEXITED(status) && WEXITSTATUS(status) == 0 &&
+        std::memcmp(parent_words, child_words, sizeof(child_words)) != 0) {
+      std::cout << "[PASS] Per-CPU keys are refreshed after fork()." << std::endl;
+    } else {
+      std::cerr << "[FAIL] Forked child repeated the parent's per-CPU stream." << std::endl;
+    }
+  } else {
+    std::cerr << "[FAIL] Could not create pipe." << std::endl;
+  }
+
+  // Forks while other threads are rekeying; a child that inherited the
+  // per-CPU mutex locked would hang until the alarm kills it.
+  options.reseed_interval_bytes = 64;
+  vscuuid::EntropySource::Configure(options);
+  std::atomic<bool> stop{false};
+  threads.clear();
+  for (int t = 0; t < 3; ++t) {
+    threads.emplace_back([&] {
+      uint64_t draw[3];
+      while (!stop.load(std::memory_order_relaxed)) {
+        vscuuid::EntropySource::Fill(std::span<uint8_t>(reinterpret_cast<uint8_t*>(draw), sizeof(draw)));
+      }
+    });
+  }
+  int hung = 0;
+  for (int i = 0; i < 100; ++i) {
+    pid_t child = fork();
+    if (child == 0) {
+      alarm(2);
+      uint64_t draw[3];
+      vscuuid::EntropySource::Fill(std::span<uint8_t>(reinterpret_cast<uint8_t*>(draw), sizeof(draw)));
+      _exit(0);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+      ++hung;
+    }
+  }
+  stop.store(true);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  if (hung == 0) {
+    std::cout << "[PASS] fork() during per-CPU rekeying leaves the child usable." << std::endl;
+  } else {
+    std::cerr << "[FAIL] " << hung << " of 100 children forked during rekeying hung." << std::endl;
+  }
+#endif
+  vscuuid::EntropySource::Configure(original);
+}
+
+void TestUuidCodec() {
+  std::cout << "[TEST] Testing the sorted UUID block codec" << std::endl;
+  vscuuid::UuidV7Generator v7_generator;
+  std::vector<vscuuid::Uuid> sorted(1000);
+  v7_generator.GenerateUuids(sorted);
+  std::sort(sorted.begin(), sorted.end());
+
+  vscuuid::CompressedUuids compressed = vscuuid::CompressedUuids::Encode(sorted);
+  std::vector<vscuuid::Uuid> decoded(sorted.size());
+  compressed.Decode(decoded);
+  vscuuid::CompressedUuids restored = vscuuid::CompressedUuids::FromBytes(compressed.bytes());
+  std::vector<vscuuid::Uuid> block(vscuuid::kCodecBlockSize);
+  std::size_t last_block = restored.DecodeBlock(restored.block_count() - 1, block);
+  if (decoded == sorted && compressed.block_count() == 8 && compressed.bytes().size() < sorted.size() * 12 &&
+      restored.size() == sorted.size() && restored.At(517) == sorted[517] && last_block == 1000 - 7 * 128 &&
+      block[last_block - 1] == sorted.back()) {
+    std::cout << "[PASS] V7 run round-trips in " << compressed.bytes().size() << " bytes." << std::endl;
+  } else {
+    std::cerr << "[FAIL] V7 run did not round-trip." << std::endl;
+  }
+
+  // 300 UUIDs sharing one high word straddle block boundaries.
+  std::vector<vscuuid::Uuid> ties;
+  for (int i = 0; i < 300; ++i) {
+    std::array<uint8_t, 16> bytes{};
+    bytes[0] = i < 10 ? 0x01 : 0x02;
+    bytes[15] = static_cast<uint8_t>(i);
+    bytes[14] = static_cast<uint8_t>(i >> 8);
+    ties.emplace_back(bytes);
+  }
+  vscuuid::CompressedUuids tied = vscuuid::CompressedUuids::Encode(ties);
+  std::array<uint8_t, 16> probe{};
+  probe[0] = 0x02;
+  probe[14] = 0x01;
+  probe[15] = 0x04;
+  std::array<uint8_t, 16> beyond{};
+  beyond[0] = 0x03;
+  bool lookups_ok = tied.LowerBound(ties[0]) == 0 && tied.LowerBound(vscuuid::Uuid(probe)) == 260 &&
+                    tied.Contains(ties[299]) && tied.LowerBound(vscuuid::Uuid(beyond)) == 300 &&
+                    !tied.Contains(vscuuid::Uuid(beyond));
+  for (std::size_t i = 0; i < sorted.size(); i += 37) {
+    lookups_ok = lookups_ok && compressed.LowerBound(sorted[i]) == i && compressed.Contains(sorted[i]);
+  }
+  if (lookups_ok) {
+    std::cout << "[PASS] Lookups use the block directory across equal high words." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Compressed lookups returned wrong positions." << std::endl;
+  }
+
+  bool unsorted_rejected = false;
+  try {
+    std::vector<vscuuid::Uuid> reversed(sorted.rbegin(), sorted.rend());
+    vscuuid::CompressedUuids::Encode(reversed);
+  } catch (const std::invalid_argument&) {
+    unsorted_rejected = true;
+  }
+  bool corrupt_rejected = false;
+  try {
+    std::vector<uint8_t> bytes(compressed.bytes().begin(), compressed.bytes().end());
+    bytes.pop_back();
+    vscuuid::CompressedUuids::FromBytes(bytes);
+  } catch (const std::runtime_error&) {
+    corrupt_rejected = true;
+  }
+  vscuuid::CompressedUuids empty = vscuuid::CompressedUuids::Encode({});
+  if (unsorted_rejected && corrupt_rejected && vscuuid::CompressedUuids::FromBytes(empty.bytes()).empty() &&
+      empty.LowerBound(sorted[0]) == 0) {
+    std::cout << "[PASS] Unsorted input and corrupt data are rejected." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Invalid codec input was accepted." << std::endl;
+  }
+}
+
+void TestUuidV7Monotonic() {
+  std::cout << "[TEST] Testing monotonic UUIDv7 generation" << std::endl;
+  vscuuid::UuidV7Generator generator;
+  generator.SetMonotonic(true);
+  std::vector<vscuuid::Uuid> uuids(20000);
+  generator.GenerateUuids(uuids);
+  bool increasing = generator.monotonic();
+  for (std::size_t i = 1; i < uuids.size(); ++i) {
+    increasing = increasing && uuids[i - 1] < uuids[i];
+  }
+  if (increasing && uuids.back().version() == 7 && (uuids.back().bytes()[8] & 0xC0) == 0x80) {
+    std::cout << "[PASS] Monotonic UUIDv7 values strictly increase." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Monotonic UUIDv7 values are out of order." << std::endl;
+  }
+}
+
+void TestNameCache() {
+  std::cout << "[TEST] Testing the name-based UUID cache" << std::endl;
+  const std::string ns = "6ba7b810-9dad-11d1-80b4-00c04fd430c8";
+  const std::string long_name(200, 'n');
+  auto cache = std::make_shared<vscuuid::NameUuidCache>(64, 4);
+  vscuuid::UuidV3Generator v3_generator;
+  vscuuid::UuidV5Generator v5_generator;
+  vscuuid::UuidV5Generator uncached;
+  v3_generator.SetCache(cache);
+  v5_generator.SetCache(cache);
+
+  bool same = true;
+  for (int round = 0; round < 2; ++round) {
+    same = same && v5_generator.GenerateUuid(ns, "example") == uncached.GenerateUuid(ns, "example") &&
+           v5_generator.GenerateUuid(ns, long_name) == uncached.GenerateUuid(ns, long_name) &&
+           v3_generator.GenerateUuid(ns, "example").version() == 3 &&
+           v5_generator.GenerateUuid(ns, "exampl") != v5_generator.GenerateUuid(ns.substr(0, 35), "eexampl");
+  }
+  vscuuid::NameCacheStats stats = cache->stats();
+  if (same && stats.hits == 5 && stats.misses == 5 && cache->capacity() == 64) {
+    std::cout << "[PASS] Cached results match uncached hashing and keys are verified." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Name cache returned wrong UUIDs (hits " << stats.hits << ", misses " << stats.misses
+              << ")." << std::endl;
+  }
+
+  // A hot name that keeps being referenced survives a stream of one-off names.
+  cache->Clear();
+  v5_generator.GenerateUuid(ns, "hot");
+  for (int i = 0; i < 1000; ++i) {
+    v5_generator.GenerateUuid(ns, "hot");
+    v5_generator.GenerateUuid(ns, "cold-" + std::to_string(i));
+  }
+  const vscuuid::NameCacheStats before = cache->stats();
+  vscuuid::Uuid hot;
+  bool hot_cached = cache->Lookup(5, ns, "hot", &hot) && hot == uncached.GenerateUuid(ns, "hot");
+  std::vector<std::thread> threads;
+  std::atomic<bool> mismatch{false};
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t] {
+      vscuuid::UuidV5Generator generator;
+      generator.SetCache(cache);
+      vscuuid::UuidV5Generator reference;
+      for (int i = 0; i < 2000; ++i) {
+        std::string name = "shared-" + std::to_string((i * (t + 1)) % 100);
+        if (generator.GenerateUuid(ns, name) != reference.GenerateUuid(ns, name)) {
+          mismatch = true;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  if (hot_cached && before.evictions > 900 && !mismatch) {
+    std::cout << "[PASS] CLOCK eviction keeps hot names under concurrent use." << std::endl;
+  } else {
+    std::cerr << "[FAIL] Name cache eviction or concurrency misbehaved." << std::endl;
+  }
+}
+
 int main(int argc, char* argv[]) {
   for (int i = 1; i < argc; ++i) {
     if (std::strcmp(argv[i], "-d") == 0 || std::strcmp(argv[i], "--debug") == 0) {
@@ -257,6 +1338,22 @@ int main(int argc, char* argv[]) {
     TestClockSequenceManager();
     TestUuidDetector();
     TestUuidV8();
+    TestUuidFormatting();
+    TestUuidScanner();
+    TestUuidStream();
+    TestNamePipeline();
+    TestUuidIndex();
+    TestEntropyForkSafety();
+    TestIsaDispatch();
+    TestCInterface();
+    TestUuidConversion();
+    TestDeterministicGenerator();
+    TestUuidColumns();
+    TestV8Layout();
+    TestPerCpuState();
+    TestUuidCodec();
+    TestUuidV7Monotonic();
+    TestNameCache();
 
     std::cout << "[INFO] All tests completed successfully." << std::endl;
   } catch (const std::exception& e) {
@@ -0,0 +1,82 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "vscuuid/name_pipeline.hh"
+
+namespace {
+
+void PrintUsage() {
+    std::cerr << "Usage:\n"
+              << "  vscuuid_cli derive <namespace-uuid> <input-file> [options]\n"
+              << "\n"
+              << "Options for derive:\n"
+              << "  --output <file>   Write results to <file> instead of stdout\n"
+              << "  --binary          Emit 16-byte binary UUIDs instead of key,uuid lines\n"
+              << "  --v3              Derive version 3 (MD5) instead of version 5 (SHA-1) UUIDs\n"
+              << "  --threads <n>     Number of hashing threads (default: all cores)\n"
+              << "  --inflight <n>    Maximum number of batches held in memory\n";
+}
+
+int RunDerive(int argc, char* argv[]) {
+    if (argc < 4) {
+        PrintUsage();
+        return 2;
+    }
+    std::string namespace_uuid = argv[2];
+    std::string input_path = argv[3];
+    std::string output_path;
+    vscuuid::NamePipelineOptions options;
+
+    for (int i = 4; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--binary") == 0) {
+            options.format = vscuuid::NameOutputFormat::kBinary;
+        } else if (std::strcmp(argv[i], "--v3") == 0) {
+            options.type = vscuuid::UuidFactory::UuidType::V3;
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            options.thread_count = static_cast<unsigned>(std::stoul(argv[++i]));
+        } else if (std::strcmp(argv[i], "--inflight") == 0 && i + 1 < argc) {
+            options.max_batches_in_flight = std::stoul(argv[++i]);
+        } else {
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    std::ofstream file;
+    std::ostream* output = &std::cout;
+    if (!output_path.empty()) {
+        file.open(output_path, std::ios::binary);
+        if (!file) {
+            std::cerr << "[ERROR] Cannot open output file: " << output_path << std::endl;
+            return 1;
+        }
+        output = &file;
+    }
+
+    std::size_t lines = vscuuid::DeriveNameUuidsFromFile(input_path, namespace_uuid, *output, options);
+    output->flush();
+    std::cerr << "[INFO] Derived " << lines << " UUIDs." << std::endl;
+    return 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        PrintUsage();
+        return 2;
+    }
+    try {
+        if (std::strcmp(argv[1], "derive") == 0) {
+            return RunDerive(argc, argv);
+        }
+        PrintUsage();
+        return 2;
+    } catch (const std::exception& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+        return 1;
+    }
+}